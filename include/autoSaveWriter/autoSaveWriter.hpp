@@ -0,0 +1,99 @@
+#pragma once
+
+#include <wx/string.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @class AutoSaveWriter
+ * @brief Writes autosaved documents on a background thread.
+ *
+ * The editor hands over a copy of the document bytes and returns immediately;
+ * a single writer thread saves the copies through
+ * FileOperations::WriteFileAtomically(). A file queued again before its
+ * previous copy was written only keeps the newest copy, so a burst of edits
+ * costs one write.
+ *
+ * Results are reported on the UI thread and never show a dialog.
+ *
+ * ### Example:
+ * @code
+ * AutoSaveWriter::Get().Enqueue(path, std::move(bytes), [](bool saved, size_t bytesWritten) { ... });
+ * @endcode
+ */
+class AutoSaveWriter
+{
+public:
+    /**
+     * @brief Receives the outcome of a write on the UI thread.
+     *
+     * Not called when the copy was superseded by a newer one or discarded.
+     */
+    using Callback = std::function<void(bool saved, size_t bytesWritten)>;
+
+    /**
+     * @brief Retrieves the global singleton instance.
+     * @return Reference to the AutoSaveWriter instance.
+     */
+    static AutoSaveWriter &Get();
+
+    /**
+     * @brief Writes every queued copy, then stops the writer thread.
+     */
+    ~AutoSaveWriter();
+
+    /**
+     * @brief Queues a copy of a document to be written.
+     * @param path The full path of the file.
+     * @param content The bytes to write.
+     * @param onWritten Called on the UI thread once the copy was written or failed.
+     */
+    void Enqueue(const wxString &path, std::string content, Callback onWritten);
+
+    /**
+     * @brief Drops the queued copy of a file and waits for a write of it in progress.
+     *
+     * Called before writing the file synchronously, so an older autosaved copy
+     * never lands on top of it.
+     *
+     * @param path The full path of the file.
+     */
+    void Discard(const wxString &path);
+
+    /**
+     * @brief Blocks until every queued copy is written.
+     */
+    void Flush();
+
+private:
+    AutoSaveWriter() = default;
+
+    /**
+     * @struct PendingWrite
+     * @brief Newest copy of a document waiting to be written.
+     */
+    struct PendingWrite
+    {
+        std::string content; ///< Bytes to write
+        Callback onWritten;  ///< Completion callback
+    };
+
+    /**
+     * @brief Writer thread loop.
+     */
+    void Run();
+
+    std::mutex m_mutex;                                     ///< Guards every member below
+    std::condition_variable m_wakeUp;                       ///< Signalled when a copy is queued or the writer stops
+    std::condition_variable m_idle;                         ///< Signalled after every write
+    std::unordered_map<wxString, PendingWrite> m_pending;   ///< Newest copy per file
+    std::deque<wxString> m_order;                           ///< Files with a pending copy, oldest first
+    wxString m_writing;                                     ///< File being written, empty when idle
+    bool m_stopping = false;                                ///< Set by the destructor
+    std::thread m_thread;                                   ///< Writer thread, started with the first copy
+};
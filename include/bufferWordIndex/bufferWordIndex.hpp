@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class BufferWordIndex
+ * @brief Counts the identifiers of the open documents of a language, for autocompletion.
+ *
+ * Every editor adds its document once when it is loaded, then only the text
+ * around each insertion or deletion is tokenized again (see
+ * Editor::UpdateWordIndex()), so typing never rescans a document. The index
+ * is shared by the editors of a language and released with the last of them.
+ *
+ * Words are kept in a map ordered on their ASCII case-folded form, so a prefix
+ * query walks a contiguous range. Every match of the range is ranked, only the
+ * best `limit` ones are kept in a bounded heap, so a frequent or nearby word is
+ * offered wherever it sorts.
+ *
+ * Used from the UI thread only.
+ *
+ * ### Example:
+ * @code
+ * auto index = BufferWordIndex::ForLanguage("c++");
+ * index->AddText(text, length);
+ * std::vector<std::string_view> words;
+ * index->Complete("valu", {}, 50, words);
+ * @endcode
+ */
+class BufferWordIndex
+{
+public:
+    /**
+     * @brief Transparent hash, so NearbyWords is probed with a std::string_view without allocating.
+     */
+    struct WordHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view word) const { return std::hash<std::string_view>()(word); }
+    };
+
+    /**
+     * @brief Distance in lines from the caret of the words seen around it.
+     */
+    using NearbyWords = std::unordered_map<std::string, int, WordHash, std::equal_to<>>;
+
+    /** @brief Words shorter than this are not indexed. */
+    static constexpr size_t MIN_WORD_LENGTH = 3;
+    /** @brief Words longer than this are not indexed. */
+    static constexpr size_t MAX_WORD_LENGTH = 64;
+
+    /**
+     * @brief Returns the index shared by the editors of a language, creating it if needed.
+     * @param language Language name (languagePreferencesStruct::name).
+     */
+    static std::shared_ptr<BufferWordIndex> ForLanguage(const std::string &language);
+
+    /**
+     * @brief Tells whether a byte belongs to a word (ASCII letters, digits, '_' and any non-ASCII byte).
+     */
+    static bool IsWordByte(unsigned char byte)
+    {
+        return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') ||
+               byte == '_' || byte >= 0x80;
+    }
+
+    /**
+     * @brief Calls a function for each indexable word of a text.
+     * @param data UTF-8 text, it should start and end on word boundaries.
+     * @param length Number of bytes.
+     * @param onWord Called with each word, as a std::string_view into data.
+     */
+    template <typename Function>
+    static void ForEachWord(const char *data, size_t length, Function &&onWord)
+    {
+        size_t i = 0;
+        while (i < length)
+        {
+            if (!IsWordByte((unsigned char)data[i]))
+            {
+                ++i;
+                continue;
+            }
+
+            const size_t start = i;
+            while (i < length && IsWordByte((unsigned char)data[i]))
+                ++i;
+
+            const size_t size = i - start;
+            if (size >= MIN_WORD_LENGTH && size <= MAX_WORD_LENGTH && !(data[start] >= '0' && data[start] <= '9'))
+                onWord(std::string_view(data + start, size));
+        }
+    }
+
+    /**
+     * @brief Counts the words of a text.
+     */
+    void AddText(const char *data, size_t length);
+
+    /**
+     * @brief Uncounts the words of a text previously added.
+     */
+    void RemoveText(const char *data, size_t length);
+
+    /**
+     * @brief Lists the indexed words starting with a prefix (case-insensitive), best first.
+     *
+     * Words seen near the caret come first, the closest first, then the most
+     * frequent words. The prefix itself is left out.
+     *
+     * @param prefix UTF-8 prefix typed by the user.
+     * @param nearby Words around the caret with their distance in lines.
+     * @param limit Maximum number of words returned.
+     * @param words Receives the words; the views stay valid until the index is modified.
+     */
+    void Complete(std::string_view prefix, const NearbyWords &nearby, size_t limit, std::vector<std::string_view> &words) const;
+
+    /**
+     * @brief Returns the number of distinct indexed words.
+     */
+    size_t GetWordCount() const { return m_words.size(); }
+
+private:
+    /**
+     * @brief Builds the map key of a word: its folded form, a NUL, then the word itself.
+     */
+    static std::string MakeKey(std::string_view word);
+
+    std::map<std::string, int> m_words; ///< Occurrence count per word, keyed by MakeKey()
+};
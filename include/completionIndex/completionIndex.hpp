@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class CompletionIndex
+ * @brief Sorted, deduplicated word list answering autocomplete prefix queries.
+ *
+ * Words are kept sorted on their ASCII case-folded form, the order Scintilla
+ * expects for a case-insensitive autocomplete list. A prefix query is a
+ * binary search followed by a scan of at most `limit` entries, so its cost
+ * does not depend on the number of words.
+ *
+ * An index is immutable once built and can be shared between editors.
+ *
+ * ### Example:
+ * @code
+ * CompletionIndex index({"while", "for", "float", "for"});
+ * std::string list;
+ * index.Complete("fo", 50, list); // list == "float for"
+ * @endcode
+ */
+class CompletionIndex
+{
+public:
+    CompletionIndex() = default;
+
+    /**
+     * @brief Builds the index.
+     * @param words UTF-8 words, in any order and possibly repeated.
+     */
+    explicit CompletionIndex(std::vector<std::string> words);
+
+    /**
+     * @brief Appends the words starting with a prefix (case-insensitive) to a list.
+     * @param prefix UTF-8 prefix typed by the user.
+     * @param limit Maximum number of words appended.
+     * @param list Receives the words separated by spaces, in index order; it is not cleared.
+     * @param exclude A word left out of the result (e.g. the word being typed), may be empty.
+     * @return The number of words appended.
+     */
+    size_t Complete(std::string_view prefix, size_t limit, std::string &list, std::string_view exclude = {}) const;
+
+    /**
+     * @brief Returns the number of indexed words.
+     */
+    size_t GetWordCount() const { return m_words.size(); }
+
+    /**
+     * @brief Returns the ASCII lower-cased form of a word, the sort key of the index.
+     */
+    static std::string Fold(std::string_view word);
+
+private:
+    /**
+     * @struct Entry
+     * @brief An indexed word and its sort key.
+     */
+    struct Entry
+    {
+        std::string folded; ///< Case-folded word
+        std::string word;   ///< Word as defined
+    };
+
+    std::vector<Entry> m_words; ///< Sorted on folded, then word
+};
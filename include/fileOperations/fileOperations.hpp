@@ -3,6 +3,8 @@
 #include <wx/string.h>
 #include <wx/file.h>
 #include <wx/filename.h>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 /**
@@ -111,4 +113,47 @@ namespace FileOperations
      * @return true if file is an image, false otherwise
      */
     bool IsImageFile(const wxString &path);
+
+    /**
+     * @brief Computes a 64-bit FNV-1a hash of a buffer
+     * @param data The bytes to hash
+     * @param size Number of bytes
+     * @param hash Hash of the preceding bytes, to hash a content given in several parts
+     * @return The hash, used to detect whether a content changed since it was last written
+     */
+    uint64_t ContentHash(const char *data, size_t size, uint64_t hash = 14695981039346656037ULL);
+
+    /**
+     * @brief Replaces the content of a file without ever leaving it half-written
+     * @param path The full path of the file to write
+     * @param data The new content
+     * @param size Number of bytes to write
+     * @param bytesWritten Receives the number of bytes written, may be nullptr
+     * @return true if the file now holds the new content, false otherwise
+     *
+     * The content is written to a temporary file in the same directory (see
+     * IsTemporaryWriteFile()), flushed to disk, then renamed over the
+     * destination. Symbolic links are resolved so the link itself is preserved.
+     * On POSIX systems the permissions of an existing file are kept, and so are
+     * its owner and group when the process is allowed to set them (otherwise
+     * the file ends up owned by the current user, as with any rename-based save).
+     * On Windows the attributes and ACLs of the file are kept by ReplaceFileW().
+     * Nothing is logged, so it can run on a worker thread; the caller reports failures.
+     * @note Will fail if:
+     * - The directory is not writable
+     * - Disk is full
+     */
+    bool WriteFileAtomically(const wxString &path, const char *data, size_t size, size_t *bytesWritten = nullptr);
+
+    /**
+     * @brief Marker in the name of the temporary files created by WriteFileAtomically()
+     */
+    inline constexpr const char *TEMPORARY_WRITE_MARKER = ".kraftaTmp-";
+
+    /**
+     * @brief Tells whether a path is a temporary file of WriteFileAtomically()
+     * @param path The path or file name to check
+     * @return true if the file is a save in progress, which the file tree, the ignore rules and the watcher skip
+     */
+    bool IsTemporaryWriteFile(const wxString &path);
 };
\ No newline at end of file
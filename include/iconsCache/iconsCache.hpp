@@ -0,0 +1,103 @@
+#pragma once
+
+#include <wx/bitmap.h>
+#include <wx/string.h>
+#include <unordered_map>
+
+/**
+ * @class IconsCache
+ * @brief Process-wide cache of decoded icon bitmaps.
+ *
+ * Every asset is decoded from disk only once per rotation and DPI scale; later
+ * requests return the same (reference counted) wxBitmap. This avoids decoding a
+ * PNG for every tree row, tab and toggle, and rotating the directory arrows with
+ * ConvertToImage()/Rotate90() on every expand or collapse.
+ *
+ * The cache is meant to be used from the UI thread only.
+ *
+ * ### Example:
+ * @code
+ * const wxBitmap &arrow = IconsCache::Get().GetIcon("dir_arrow.png", 90);
+ * const wxBitmap &icon = IconsCache::Get().GetFileIcon("/project/main.cpp");
+ * @endcode
+ */
+class IconsCache
+{
+public:
+    /**
+     * @brief Retrieves the global singleton instance.
+     * @return Reference to the IconsCache instance.
+     */
+    static IconsCache &Get();
+
+    /**
+     * @brief Returns the bitmap decoded from an image file.
+     * @param path Absolute path of the PNG file.
+     * @param rotation Clockwise rotation in degrees, multiple of 90.
+     * @param scale DPI scale factor the bitmap is rendered for.
+     * @return The cached bitmap, invalid if the file could not be decoded.
+     */
+    const wxBitmap &GetBitmap(const wxString &path, int rotation = 0, double scale = 1.0);
+
+    /**
+     * @brief Returns a bitmap from the application icons directory.
+     * @param name File name of the icon (e.g. "close.png").
+     * @param rotation Clockwise rotation in degrees, multiple of 90.
+     * @param scale DPI scale factor the bitmap is rendered for.
+     */
+    const wxBitmap &GetIcon(const wxString &name, int rotation = 0, double scale = 1.0);
+
+    /**
+     * @brief Returns the icon representing a file in the tree and the tabs.
+     *
+     * Images use the generic image icon, other files the icon of their language.
+     *
+     * @param filePath Path of the represented file.
+     * @param scale DPI scale factor the bitmap is rendered for.
+     */
+    const wxBitmap &GetFileIcon(const wxString &filePath, double scale = 1.0);
+
+    /**
+     * @brief Drops every cached bitmap (e.g. after a theme change).
+     */
+    void Clear();
+
+private:
+    IconsCache() = default;
+
+    /**
+     * @struct Key
+     * @brief Identifies a decoded variant of an icon.
+     */
+    struct Key
+    {
+        wxString path;    ///< Absolute path of the image file
+        int rotation;     ///< Clockwise rotation in degrees
+        int scalePercent; ///< DPI scale factor in percent
+
+        bool operator==(const Key &other) const
+        {
+            return rotation == other.rotation && scalePercent == other.scalePercent && path == other.path;
+        }
+    };
+
+    /**
+     * @struct KeyHash
+     * @brief Hash functor combining the members of Key.
+     */
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            size_t hash = std::hash<wxString>()(key.path);
+            hash ^= std::hash<int>()(key.rotation) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<int>()(key.scalePercent) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    std::unordered_map<Key, wxBitmap, KeyHash> m_bitmaps; ///< Decoded bitmaps keyed by path, rotation and scale
+
+    IconsCache(const IconsCache &) = delete;
+    IconsCache &operator=(const IconsCache &) = delete;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <wx/string.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @enum IgnoreScope
+ * @brief Selects which exclusion lists apply to a query.
+ */
+enum class IgnoreScope
+{
+    Explorer, ///< Ignore files and files/exclude (file tree)
+    Search    ///< Explorer rules plus search/exclude (quick open, project search)
+};
+
+/**
+ * @class IgnoreEngine
+ * @brief Decides which project entries are skipped by the file tree, quick open and search.
+ *
+ * Rules come from the `.gitignore` and `.ignore` files of every directory of
+ * the project and from the user exclude lists (`files/exclude`,
+ * `search/exclude`). The temporary files of FileOperations::WriteFileAtomically()
+ * are always ignored. Each line is compiled once into a rule, literal names and
+ * `*.ext` patterns are matched without running the glob matcher, and the rules
+ * of a directory are read from disk only the first time an entry of that
+ * directory is queried.
+ *
+ * The engine is thread-safe, so background directory listings can query it.
+ * Ignore files are read outside of the lock, a query never waits for the disk
+ * reads of another thread.
+ *
+ * ### Example:
+ * @code
+ * IgnoreEngine::Get().SetRoot("/project/");
+ * if (IgnoreEngine::Get().IsIgnored("/project/build/", true)) { ... }
+ * @endcode
+ */
+class IgnoreEngine
+{
+public:
+    /**
+     * @brief Retrieves the global singleton instance.
+     * @return Reference to the IgnoreEngine instance.
+     */
+    static IgnoreEngine &Get();
+
+    /**
+     * @brief Sets the project root the ignore files are looked up from.
+     *
+     * Changing the root drops every cached rule.
+     *
+     * @param root Absolute project path, ending with the path separator.
+     */
+    void SetRoot(const wxString &root);
+
+    /**
+     * @brief Reloads the user exclude lists (e.g. after settings.json was saved).
+     *
+     * The cached rules are only dropped when `files/exclude`, `search/exclude`
+     * or `files/useIgnoreFiles` changed.
+     *
+     * @return True if one of those settings changed, false otherwise.
+     */
+    bool Reload();
+
+    /**
+     * @brief Drops the cached rules of a directory (e.g. after its .gitignore changed).
+     * @param directory Absolute directory path.
+     */
+    void InvalidateDirectory(const wxString &directory);
+
+    /**
+     * @brief Tells whether a file name holds ignore rules.
+     * @param name The file name.
+     */
+    static bool IsIgnoreFile(const wxString &name);
+
+    /**
+     * @brief Tells whether an entry of the project must be skipped.
+     * @param path Absolute path of the entry.
+     * @param isDir Whether the entry is a directory.
+     * @param scope Which exclusion lists apply.
+     * @return True if the entry is excluded, false otherwise or if it lies outside the project.
+     */
+    bool IsIgnored(const wxString &path, bool isDir, IgnoreScope scope = IgnoreScope::Explorer);
+
+private:
+    IgnoreEngine();
+
+    /**
+     * @enum RuleKind
+     * @brief How a compiled rule is matched.
+     */
+    enum class RuleKind
+    {
+        Literal,   ///< Exact name or path comparison
+        Extension, ///< "*.ext": suffix comparison
+        Glob       ///< Generic wildcard pattern
+    };
+
+    /**
+     * @struct IgnoreRule
+     * @brief A compiled line of an ignore file.
+     */
+    struct IgnoreRule
+    {
+        std::string pattern;            ///< Pattern (the suffix for Extension rules)
+        RuleKind kind = RuleKind::Glob; ///< Matching strategy
+        bool negated = false;           ///< "!pattern": re-includes the entry
+        bool dirOnly = false;           ///< "pattern/": only matches directories
+        bool anchored = false;          ///< Contains a slash: matched against the path relative to the ignore file
+    };
+
+    /**
+     * @brief Compiles the lines of an ignore file or exclude list.
+     * @param lines The raw lines (UTF-8).
+     * @param rules Receives the compiled rules.
+     */
+    static void CompileRules(const std::vector<std::string> &lines, std::vector<IgnoreRule> &rules);
+
+    /**
+     * @brief Reads and compiles the rules declared in a directory, without touching the cache.
+     * @param root Project root, ending with the path separator.
+     * @param relativeDir Directory path relative to the root ("" or ending with '/').
+     * @return The rules of the directory.
+     */
+    static std::vector<IgnoreRule> ReadDirectoryRules(const wxString &root, const std::string &relativeDir);
+
+    /**
+     * @brief Evaluates a list of rules, the last matching rule wins.
+     * @param rules The rules to evaluate.
+     * @param relativePath Path relative to the directory declaring the rules.
+     * @param isDir Whether the entry is a directory.
+     * @param ignored Updated when a rule matches.
+     */
+    static void ApplyRules(const std::vector<IgnoreRule> &rules, const std::string &relativePath, bool isDir, bool &ignored);
+
+    /**
+     * @brief Matches a single rule.
+     */
+    static bool MatchRule(const IgnoreRule &rule, const std::string &relativePath, bool isDir);
+
+    /**
+     * @brief Matches a gitignore glob ('*', '?', '[...]', '**').
+     */
+    static bool MatchGlob(const char *pattern, const char *text);
+
+    std::mutex m_mutex;                      ///< Guards the caches against concurrent listings
+    wxString m_root;                         ///< Project root, ending with the path separator
+    bool m_useIgnoreFiles = true;            ///< Value of the files/useIgnoreFiles setting
+    std::vector<IgnoreRule> m_excludeRules;  ///< Compiled files/exclude list
+    std::vector<IgnoreRule> m_searchRules;   ///< Compiled search/exclude list
+    std::vector<std::string> m_excludeLines; ///< files/exclude as last loaded
+    std::vector<std::string> m_searchLines;  ///< search/exclude as last loaded
+    std::unordered_map<std::string, std::vector<IgnoreRule>> m_directoryRules; ///< Rules keyed by relative directory
+    uint64_t m_generation = 0;               ///< Bumped whenever cached rules are dropped, invalidates reads in flight
+
+    IgnoreEngine(const IgnoreEngine &) = delete;
+    IgnoreEngine &operator=(const IgnoreEngine &) = delete;
+};
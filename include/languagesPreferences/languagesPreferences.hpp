@@ -11,8 +11,14 @@
 #include <nlohmann/json.hpp>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <functional>
+#include <memory>
+#include <vector>
 #include <wx/stc/stc.h>
 
+#include "completionIndex/completionIndex.hpp"
+
 using json = nlohmann::json; ///< Alias for nlohmann::json namespace
 
 /**
@@ -30,6 +36,19 @@ struct languagePreferencesStruct
     json styles;      ///< Visual styling rules (colors, fonts, etc.)
 };
 
+/**
+ * @struct languageFileInfoStruct
+ * @brief Precomputed language id and icon of a file extension
+ *
+ * Built once from extensionsList.json and each language's preferences.json,
+ * so the file tree and the tab strip never parse JSON to draw an icon.
+ */
+struct languageFileInfoStruct
+{
+    std::string languageId; ///< Language directory name (e.g. "c++")
+    wxString iconPath;      ///< Absolute path to the language icon
+};
+
 /**
  * @class LanguagesPreferences
  * @brief Singleton manager for language-specific editor configurations
@@ -88,10 +107,31 @@ public:
      *
      * Returns "unknown" icon if no specific icon configured
      */
-    wxString GetLanguageIconPath(const wxString &path);
+    const wxString &GetLanguageIconPath(const wxString &path) const;
+
+    /**
+     * @brief Gets the precomputed language id and icon of a file
+     * @param path File path used to determine language (via extension)
+     * @return Entry of the extension table, or the default language entry
+     *
+     * The lookup is a hash probe on the extension, it does not allocate.
+     */
+    const languageFileInfoStruct &GetLanguageFileInfo(const wxString &path) const;
 
+    /**
+     * @brief Lists the keywords of a language
+     * @param currentLanguagePreferences Active language config
+     * @return Every word of "syntax.keyword_lists", deduplicated and sorted
+     */
     std::vector<wxString> GetAutoCompleteWordsList(const languagePreferencesStruct &currentLanguagePreferences);
 
+    /**
+     * @brief Gets the autocomplete index of a language
+     * @param currentLanguagePreferences Active language config
+     * @return Index of the language keywords, built on first use and shared by every editor
+     */
+    std::shared_ptr<const CompletionIndex> GetCompletionIndex(const languagePreferencesStruct &currentLanguagePreferences);
+
 private:
     // Error message constants
     static constexpr const char *ERROR_LANGUAGES_PREFERENCES_FILE_NOT_FOUND =
@@ -137,18 +177,6 @@ private:
     void SetupReservedWords(const languagePreferencesStruct &currentLanguagePreferences,
                             wxStyledTextCtrl *editor);
 
-    /**
-     * @brief Configures autocomplete word suggestions
-     * @param currentLanguagePreferences Active language config
-     * @param editor Main editor control
-     *
-     * Builds a candidate list from "syntax.keyword_lists"
-     * and attaches a listener to display suggestions
-     * as the user types.
-     */
-    void SetupAutoCompleteWords(const languagePreferencesStruct &currentLanguagePreferences,
-                                wxStyledTextCtrl *editor);
-
     /**
      * @brief Applies visual styles to editor components
      * @param currentLanguagePreferences Active language config
@@ -178,8 +206,28 @@ private:
      */
     void LoadExtensionsList();
 
+    /**
+     * @brief Builds the immutable extension table
+     *
+     * Reads the "icon_file_name" of every language referenced by
+     * extensionsList.json once and fills m_fileInfoByExt and m_defaultFileInfo.
+     */
+    void BuildLanguageFileTable();
+
+    /**
+     * @brief Transparent hash allowing std::string_view lookups on std::string keys
+     */
+    struct ExtensionHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+    };
+
     std::unordered_map<std::string, languagePreferencesStruct> m_languages; ///< Cached language configurations
     std::unordered_map<std::string, std::string> m_extToLang;               ///< File extension to language name mapping
+    std::unordered_map<std::string, languageFileInfoStruct, ExtensionHash, std::equal_to<>> m_fileInfoByExt; ///< File extension to language id and icon
+    languageFileInfoStruct m_defaultFileInfo;                               ///< Entry used for unknown extensions
+    std::unordered_map<std::string, std::shared_ptr<const CompletionIndex>> m_completionIndexes; ///< Keyword index per language name
     json m_preferencesObject;                                               ///< Root JSON preferences object (if needed)
     json m_lexerStylesObject;                                               ///< Root JSON styles object (if needed)
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <wx/string.h>
+#include <cstddef>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The content is paged in by the operating system as it is read, so a huge
+ * file can be consumed sequentially without first copying it into memory.
+ * Works with `mmap` on POSIX systems and file mappings on Windows.
+ *
+ * ### Example:
+ * @code
+ * MappedFile file;
+ * if (file.Open("/project/huge.log"))
+ *     Consume(file.GetData(), file.GetSize());
+ * @endcode
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Maps a file, closing the previously mapped one.
+     * @param path The file path.
+     * @return true if the file was mapped (an empty file maps to no data).
+     */
+    bool Open(const wxString &path);
+
+    /**
+     * @brief Unmaps the file, GetData() returns nullptr afterwards.
+     */
+    void Close();
+
+    /**
+     * @brief Returns the mapped content, nullptr for an empty or closed file.
+     */
+    const char *GetData() const { return m_data; }
+
+    /**
+     * @brief Returns the size of the mapped content in bytes.
+     */
+    size_t GetSize() const { return m_size; }
+
+private:
+    const char *m_data = nullptr; ///< First byte of the mapping
+    size_t m_size = 0;            ///< Length of the mapping
+#ifdef __WXMSW__
+    void *m_file = nullptr;    ///< File HANDLE
+    void *m_mapping = nullptr; ///< File mapping HANDLE
+#endif
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+};
@@ -119,6 +119,7 @@ namespace Event
         RenameDir = ID_BASE_FILE + 12,
         DeleteDir = ID_BASE_FILE + 13,
         ToggleAutosave = ID_BASE_FILE + 14,
+        ExpandSubfolders = ID_BASE_FILE + 15,
     };
 
     /**
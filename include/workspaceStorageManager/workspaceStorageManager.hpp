@@ -71,6 +71,36 @@ public:
         return {T(), false};
     }
 
+    /**
+     * @brief Stores a value in the current workspace data and saves it to disk.
+     */
+    template <typename T>
+    bool SetSetting(const std::string& settingName, const T& value) {
+        json data;
+        {
+            std::lock_guard<std::mutex> lock(storageMutex);
+            if (StoragePath.empty()) return false;
+            data = currentData;
+        }
+        data[settingName] = value;
+        return Update(data);
+    }
+
+    /**
+     * @brief Stores several values in the current workspace data and saves it to disk once.
+     * @param values Object whose members replace the settings of the same name.
+     */
+    bool SetSettings(const json& values) {
+        json data;
+        {
+            std::lock_guard<std::mutex> lock(storageMutex);
+            if (StoragePath.empty() || !values.is_object()) return false;
+            data = currentData;
+        }
+        for (const auto& [name, value] : values.items()) data[name] = value;
+        return Update(data);
+    }
+
     json currentData;
 
 private:
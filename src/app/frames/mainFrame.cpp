@@ -1,4 +1,5 @@
 #include "mainFrame.hpp"
+#include "autoSaveWriter/autoSaveWriter.hpp"
 
 MainFrame::MainFrame(const wxString &title)
     : wxFrame(nullptr, wxID_ANY, title), m_watcher(nullptr), m_followLinks(false)
@@ -349,6 +350,25 @@ void MainFrame::AddEntry(wxFSWPathType type, wxString filename)
     }
 }
 
+void MainFrame::RemoveEntry(wxString filename)
+{
+    if (!m_watcher || filename.empty())
+        return;
+
+    wxFileName fn = wxFileName::DirName(filename);
+
+    wxArrayString watchedPaths;
+    m_watcher->GetWatchedPaths(&watchedPaths);
+    for (const auto &watchedPath : watchedPaths)
+    {
+        if (wxFileName::DirName(watchedPath).SameAs(fn))
+        {
+            m_watcher->Remove(fn);
+            return;
+        }
+    }
+}
+
 void MainFrame::OnFileSystemEvent(wxFileSystemWatcherEvent &event)
 {
     m_filesTree->OnFileSystemEvent(
@@ -396,6 +416,10 @@ void MainFrame::LoadPath(wxString path)
         return;
     }
 
+    m_filesTree->SaveTreeState();
+    // The editor states belong to the workspace being left
+    m_tabs->CloseAllFiles();
+
     ProjectSettings::Get().ClearProject();
     ProjectSettings::Get().SetProjectPath(normalizedPath);
     ProjectSettings::Get().SetProjectName(wxFileNameFromPath(fn.GetFullPath().RemoveLast()));
@@ -407,7 +431,6 @@ void MainFrame::LoadPath(wxString path)
     wxConfig globalConfig("krafta-editor");
     globalConfig.Write("workspace", normalizedPath);
 
-    m_tabs->CloseAllFiles();
     SetTitle("Krafta Editor - " + ProjectSettings::Get().GetProjectName());
 
     if (GetMenuBar() && m_menuBar->recentsWorkspacesMenu)
@@ -415,8 +438,15 @@ void MainFrame::LoadPath(wxString path)
         UpdateRecentWorkspacesMenu(m_menuBar->recentsWorkspacesMenu);
     }
 
+    if (m_watcher)
+        m_watcher->RemoveAll();
+
     m_filesTree->LoadProject(m_filesTree->GetProjectFilesContainer(), normalizedPath);
-    AddEntry(wxFSWPath_Tree, normalizedPath);
+
+    if (UserSettingsManager::Get().GetSetting<bool>("fileWatcher/watchWholeTree").value)
+        AddEntry(wxFSWPath_Tree, normalizedPath);
+    else
+        AddEntry(wxFSWPath_Dir, normalizedPath);
 
     auto lastFile = WorkspaceStorageManager::Get().GetSetting<std::string>("last_focused_file");
     if (lastFile.found && wxFileExists(lastFile.value))
@@ -504,9 +534,13 @@ void MainFrame::OnCloseFolder(wxCommandEvent &WXUNUSED(event))
         return;
     }
 
+    m_filesTree->SaveTreeState();
     m_filesTree->CloseProject();
     m_tabs->CloseAllFiles();
 
+    if (m_watcher)
+        m_watcher->RemoveAll();
+
     wxConfig *config = new wxConfig("krafta-editor");
     config->Write("workspace", "");
     delete config;
@@ -525,7 +559,7 @@ void MainFrame::OnToggleSearch(wxCommandEvent &WXUNUSED(event))
     else
     {
         wxString defaultLabel = "";
-        auto currentEditor = ((wxStyledTextCtrl *)wxFindWindowByLabel(ProjectSettings::Get().GetCurrentlyFileOpen() + "_codeEditor"));
+        auto currentEditor = ((Editor *)wxFindWindowByLabel(ProjectSettings::Get().GetCurrentlyFileOpen() + "_codeEditor"));
         if (currentEditor)
             defaultLabel = currentEditor->GetSelectedText();
 
@@ -692,11 +726,18 @@ void MainFrame::OnClose(wxCloseEvent &event)
     }
     isClosing = true;
 
+    if (m_filesTree)
+    {
+        m_filesTree->SaveTreeState();
+    }
+
     if (m_tabs)
     {
         m_tabs->CloseAllFiles();
     }
 
+    AutoSaveWriter::Get().Flush();
+
     if (m_watcher)
     {
         m_watcher->RemoveAll();
@@ -97,6 +97,12 @@ public:
      */
     void AddEntry(wxFSWPathType type, wxString filename = wxString());
 
+    /**
+     * @brief Removes a directory previously added with AddEntry() from the file system watcher.
+     * @param filename The path of the watched directory.
+     */
+    void RemoveEntry(wxString filename);
+
     /**
      * @brief Creates and initializes the wxFileSystemWatcher if a project folder is open.
      * @return **true** if the watcher was successfully created and attached to the event loop; **false** otherwise.
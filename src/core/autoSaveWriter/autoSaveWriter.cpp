@@ -0,0 +1,95 @@
+#include "autoSaveWriter/autoSaveWriter.hpp"
+#include "fileOperations/fileOperations.hpp"
+
+#include <wx/app.h>
+#include <algorithm>
+
+AutoSaveWriter &AutoSaveWriter::Get()
+{
+    static AutoSaveWriter instance;
+    return instance;
+}
+
+AutoSaveWriter::~AutoSaveWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void AutoSaveWriter::Enqueue(const wxString &path, std::string content, Callback onWritten)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto pending = m_pending.find(path);
+        if (pending != m_pending.end())
+            pending->second = {std::move(content), std::move(onWritten)};
+        else
+        {
+            m_pending.emplace(path, PendingWrite{std::move(content), std::move(onWritten)});
+            m_order.push_back(path);
+        }
+
+        if (!m_thread.joinable())
+            m_thread = std::thread(&AutoSaveWriter::Run, this);
+    }
+    m_wakeUp.notify_one();
+}
+
+void AutoSaveWriter::Discard(const wxString &path)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_pending.erase(path))
+        m_order.erase(std::find(m_order.begin(), m_order.end(), path));
+
+    m_idle.wait(lock, [&]()
+                { return m_writing != path; });
+}
+
+void AutoSaveWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [&]()
+                { return m_order.empty() && m_writing.empty(); });
+}
+
+void AutoSaveWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeUp.wait(lock, [&]()
+                      { return m_stopping || !m_order.empty(); });
+
+        // Queued copies are still written when stopping, they hold the user's edits
+        if (m_order.empty())
+            return;
+
+        m_writing = m_order.front();
+        m_order.pop_front();
+        auto pending = m_pending.extract(m_writing);
+        PendingWrite write = std::move(pending.mapped());
+        const wxString path = m_writing;
+
+        lock.unlock();
+        size_t bytesWritten = 0;
+        const bool saved = FileOperations::WriteFileAtomically(path, write.content.data(), write.content.size(), &bytesWritten);
+        write.content.clear();
+        lock.lock();
+
+        if (wxTheApp && write.onWritten && !m_stopping)
+        {
+            wxTheApp->CallAfter([onWritten = std::move(write.onWritten), saved, bytesWritten]()
+                                { onWritten(saved, bytesWritten); });
+        }
+
+        m_writing.clear();
+        m_idle.notify_all();
+    }
+}
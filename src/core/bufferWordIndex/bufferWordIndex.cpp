@@ -0,0 +1,102 @@
+#include "bufferWordIndex/bufferWordIndex.hpp"
+#include "completionIndex/completionIndex.hpp"
+
+#include <algorithm>
+#include <climits>
+
+std::shared_ptr<BufferWordIndex> BufferWordIndex::ForLanguage(const std::string &language)
+{
+    static std::unordered_map<std::string, std::weak_ptr<BufferWordIndex>> indexes;
+
+    auto &cached = indexes[language];
+    auto index = cached.lock();
+    if (!index)
+    {
+        index = std::make_shared<BufferWordIndex>();
+        cached = index;
+    }
+    return index;
+}
+
+std::string BufferWordIndex::MakeKey(std::string_view word)
+{
+    std::string key = CompletionIndex::Fold(word);
+    key += '\0';
+    key += word;
+    return key;
+}
+
+void BufferWordIndex::AddText(const char *data, size_t length)
+{
+    ForEachWord(data, length, [&](std::string_view word)
+                { ++m_words[MakeKey(word)]; });
+}
+
+void BufferWordIndex::RemoveText(const char *data, size_t length)
+{
+    ForEachWord(data, length, [&](std::string_view word)
+                {
+        auto entry = m_words.find(MakeKey(word));
+        if (entry != m_words.end() && --entry->second <= 0)
+            m_words.erase(entry); });
+}
+
+void BufferWordIndex::Complete(std::string_view prefix, const NearbyWords &nearby, size_t limit, std::vector<std::string_view> &words) const
+{
+    struct Candidate
+    {
+        std::string_view word;
+        int distance;
+        int count;
+    };
+
+    // Closest to the caret first, then the most frequent
+    auto better = [](const Candidate &a, const Candidate &b)
+    {
+        if (a.distance != b.distance)
+            return a.distance < b.distance;
+        if (a.count != b.count)
+            return a.count > b.count;
+        return a.word < b.word;
+    };
+
+    if (limit == 0)
+        return;
+
+    const std::string folded = CompletionIndex::Fold(prefix);
+
+    // Max-heap on "better": its front is the worst candidate kept so far
+    std::vector<Candidate> best;
+    best.reserve(limit);
+
+    for (auto entry = m_words.lower_bound(folded); entry != m_words.end(); ++entry)
+    {
+        const std::string &key = entry->first;
+        if (key.compare(0, folded.size(), folded) != 0)
+            break;
+
+        const size_t separator = key.find('\0');
+        std::string_view word(key.data() + separator + 1, key.size() - separator - 1);
+        if (word == prefix)
+            continue;
+
+        auto near = nearby.find(word);
+        const Candidate candidate{word, near != nearby.end() ? near->second : INT_MAX, entry->second};
+
+        if (best.size() < limit)
+        {
+            best.push_back(candidate);
+            std::push_heap(best.begin(), best.end(), better);
+        }
+        else if (better(candidate, best.front()))
+        {
+            std::pop_heap(best.begin(), best.end(), better);
+            best.back() = candidate;
+            std::push_heap(best.begin(), best.end(), better);
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end(), better);
+    for (const auto &candidate : best)
+        words.push_back(candidate.word);
+}
@@ -0,0 +1,59 @@
+#include "completionIndex/completionIndex.hpp"
+
+#include <algorithm>
+
+CompletionIndex::CompletionIndex(std::vector<std::string> words)
+{
+    m_words.reserve(words.size());
+    for (auto &word : words)
+    {
+        if (word.empty())
+            continue;
+        std::string folded = Fold(word);
+        m_words.push_back({std::move(folded), std::move(word)});
+    }
+
+    std::sort(m_words.begin(), m_words.end(), [](const Entry &a, const Entry &b)
+              {
+        if (a.folded != b.folded)
+            return a.folded < b.folded;
+        return a.word < b.word; });
+
+    m_words.erase(std::unique(m_words.begin(), m_words.end(), [](const Entry &a, const Entry &b)
+                              { return a.word == b.word; }),
+                  m_words.end());
+}
+
+std::string CompletionIndex::Fold(std::string_view word)
+{
+    std::string folded(word);
+    for (auto &c : folded)
+    {
+        if (c >= 'A' && c <= 'Z')
+            c = (char)(c - 'A' + 'a');
+    }
+    return folded;
+}
+
+size_t CompletionIndex::Complete(std::string_view prefix, size_t limit, std::string &list, std::string_view exclude) const
+{
+    const std::string folded = Fold(prefix);
+
+    auto entry = std::lower_bound(m_words.begin(), m_words.end(), folded, [](const Entry &candidate, const std::string &key)
+                                  { return candidate.folded < key; });
+
+    size_t count = 0;
+    for (; entry != m_words.end() && count < limit; ++entry)
+    {
+        if (entry->folded.compare(0, folded.size(), folded) != 0)
+            break;
+        if (entry->word == exclude)
+            continue;
+
+        if (!list.empty())
+            list += ' ';
+        list += entry->word;
+        ++count;
+    }
+    return count;
+}
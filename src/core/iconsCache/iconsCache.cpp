@@ -0,0 +1,59 @@
+#include "iconsCache/iconsCache.hpp"
+#include "appPaths/appPaths.hpp"
+#include "fileOperations/fileOperations.hpp"
+#include "languagesPreferences/languagesPreferences.hpp"
+
+#include <wx/image.h>
+#include <cmath>
+
+IconsCache &IconsCache::Get()
+{
+    static IconsCache instance;
+    return instance;
+}
+
+const wxBitmap &IconsCache::GetBitmap(const wxString &path, int rotation, double scale)
+{
+    rotation = ((rotation % 360) + 360) % 360;
+    Key key{path, rotation, (int)std::lround(scale * 100)};
+
+    auto cached = m_bitmaps.find(key);
+    if (cached != m_bitmaps.end())
+        return cached->second;
+
+    wxBitmap bitmap;
+    wxImage image;
+    if (!path.IsEmpty() && image.LoadFile(path, wxBITMAP_TYPE_PNG))
+    {
+        for (int quarter = 0; quarter < rotation / 90; ++quarter)
+            image = image.Rotate90(true);
+
+        if (key.scalePercent != 100)
+        {
+            image.Rescale(std::lround(image.GetWidth() * scale), std::lround(image.GetHeight() * scale), wxIMAGE_QUALITY_HIGH);
+            bitmap = wxBitmap(image, -1, scale);
+        }
+        else
+            bitmap = wxBitmap(image, -1);
+    }
+
+    return m_bitmaps.emplace(std::move(key), bitmap).first->second;
+}
+
+const wxBitmap &IconsCache::GetIcon(const wxString &name, int rotation, double scale)
+{
+    static const wxString iconsDir = ApplicationPaths::AssetsPath("icons");
+    return GetBitmap(iconsDir + name, rotation, scale);
+}
+
+const wxBitmap &IconsCache::GetFileIcon(const wxString &filePath, double scale)
+{
+    if (FileOperations::IsImageFile(filePath))
+        return GetBitmap(ApplicationPaths::GetLanguageIcon("image"), 0, scale);
+    return GetBitmap(LanguagesPreferences::Get().GetLanguageIconPath(filePath), 0, scale);
+}
+
+void IconsCache::Clear()
+{
+    m_bitmaps.clear();
+}
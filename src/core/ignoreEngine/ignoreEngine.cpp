@@ -0,0 +1,371 @@
+#include "ignoreEngine/ignoreEngine.hpp"
+#include "userSettings/userSettings.hpp"
+#include "platformInfos/platformInfos.hpp"
+#include "fileOperations/fileOperations.hpp"
+
+#include <wx/filename.h>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+IgnoreEngine &IgnoreEngine::Get()
+{
+    static IgnoreEngine instance;
+    return instance;
+}
+
+IgnoreEngine::IgnoreEngine()
+{
+    Reload();
+}
+
+void IgnoreEngine::SetRoot(const wxString &root)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (root == m_root)
+        return;
+
+    m_root = root;
+    if (!m_root.IsEmpty() && m_root.Last() != PlatformInfos::OsPathSeparator())
+        m_root.Append(PlatformInfos::OsPathSeparator());
+    m_directoryRules.clear();
+    ++m_generation;
+}
+
+bool IgnoreEngine::Reload()
+{
+    auto useIgnoreFiles = UserSettingsManager::Get().GetSetting<bool>("files/useIgnoreFiles");
+    auto exclude = UserSettingsManager::Get().GetSetting<std::vector<std::string>>("files/exclude");
+    auto searchExclude = UserSettingsManager::Get().GetSetting<std::vector<std::string>>("search/exclude");
+
+    const bool useFiles = !useIgnoreFiles.found || useIgnoreFiles.value;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_generation > 0 && useFiles == m_useIgnoreFiles && exclude.value == m_excludeLines && searchExclude.value == m_searchLines)
+        return false;
+
+    m_useIgnoreFiles = useFiles;
+    m_excludeLines = std::move(exclude.value);
+    m_searchLines = std::move(searchExclude.value);
+
+    m_excludeRules.clear();
+    m_searchRules.clear();
+    CompileRules(m_excludeLines, m_excludeRules);
+    CompileRules(m_searchLines, m_searchRules);
+    m_directoryRules.clear();
+    ++m_generation;
+    return true;
+}
+
+void IgnoreEngine::InvalidateDirectory(const wxString &directory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_root.IsEmpty() || !directory.StartsWith(m_root))
+        return;
+
+    std::string relativeDir = directory.Mid(m_root.length()).utf8_string();
+    if (PlatformInfos::OsPathSeparator() != '/')
+        std::replace(relativeDir.begin(), relativeDir.end(), (char)PlatformInfos::OsPathSeparator(), '/');
+    if (!relativeDir.empty() && relativeDir.back() != '/')
+        relativeDir.push_back('/');
+
+    if (m_directoryRules.erase(relativeDir))
+        ++m_generation;
+}
+
+bool IgnoreEngine::IsIgnoreFile(const wxString &name)
+{
+    return name == ".gitignore" || name == ".ignore";
+}
+
+bool IgnoreEngine::IsIgnored(const wxString &path, bool isDir, IgnoreScope scope)
+{
+    // A save in progress, whatever the rules and the project
+    if (!isDir && FileOperations::IsTemporaryWriteFile(path))
+        return true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        if (m_root.IsEmpty() || !path.StartsWith(m_root))
+            return false;
+
+        std::string relativePath = path.Mid(m_root.length()).utf8_string();
+        if (PlatformInfos::OsPathSeparator() != '/')
+            std::replace(relativePath.begin(), relativePath.end(), (char)PlatformInfos::OsPathSeparator(), '/');
+        while (!relativePath.empty() && relativePath.back() == '/')
+            relativePath.pop_back();
+        if (relativePath.empty())
+            return false;
+
+        bool ignored = false;
+        ApplyRules(m_excludeRules, relativePath, isDir, ignored);
+        if (!ignored && scope == IgnoreScope::Search)
+            ApplyRules(m_searchRules, relativePath, isDir, ignored);
+        if (ignored || !m_useIgnoreFiles)
+            return ignored;
+
+        // Calls a function with each ancestor directory of the entry, the root first
+        auto forEachDirectory = [&](auto &&onDirectory)
+        {
+            for (size_t separator = 0;;)
+            {
+                onDirectory(relativePath.substr(0, separator), separator);
+
+                size_t next = relativePath.find('/', separator);
+                if (next == std::string::npos)
+                    break;
+                separator = next + 1;
+            }
+        };
+
+        std::vector<std::string> missing;
+        forEachDirectory([&](std::string relativeDir, size_t)
+                         {
+            if (!m_directoryRules.contains(relativeDir))
+                missing.push_back(std::move(relativeDir)); });
+
+        if (missing.empty())
+        {
+            // Rules of deeper directories take precedence, so they are applied last
+            forEachDirectory([&](const std::string &relativeDir, size_t separator)
+                             { ApplyRules(m_directoryRules.at(relativeDir), relativePath.substr(separator), isDir, ignored); });
+            return ignored;
+        }
+
+        // Ignore files are read without the lock, so the UI thread never waits behind a listing reading the disk
+        const wxString root = m_root;
+        const uint64_t generation = m_generation;
+        lock.unlock();
+
+        std::vector<std::vector<IgnoreRule>> loaded;
+        loaded.reserve(missing.size());
+        for (const auto &relativeDir : missing)
+            loaded.push_back(ReadDirectoryRules(root, relativeDir));
+
+        lock.lock();
+
+        // Rules read before the root changed or a cache was dropped are stale, the query then starts over
+        if (generation == m_generation)
+        {
+            for (size_t i = 0; i < missing.size(); ++i)
+                m_directoryRules.emplace(std::move(missing[i]), std::move(loaded[i]));
+        }
+    }
+}
+
+std::vector<IgnoreEngine::IgnoreRule> IgnoreEngine::ReadDirectoryRules(const wxString &root, const std::string &relativeDir)
+{
+    std::vector<std::string> lines;
+    for (const char *fileName : {".gitignore", ".ignore"})
+    {
+        wxString filePath = root + wxString::FromUTF8(relativeDir) + fileName;
+        if (!wxFileExists(filePath))
+            continue;
+
+        std::ifstream file(filePath.fn_str());
+        std::string line;
+        while (std::getline(file, line))
+            lines.push_back(line);
+    }
+
+    std::vector<IgnoreRule> rules;
+    CompileRules(lines, rules);
+    return rules;
+}
+
+void IgnoreEngine::CompileRules(const std::vector<std::string> &lines, std::vector<IgnoreRule> &rules)
+{
+    for (std::string line : lines)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        while (!line.empty() && line.back() == ' ' && (line.size() < 2 || line[line.size() - 2] != '\\'))
+            line.pop_back();
+
+        IgnoreRule rule;
+        if (line[0] == '!')
+        {
+            rule.negated = true;
+            line.erase(0, 1);
+        }
+        else if (line.size() > 1 && line[0] == '\\' && (line[1] == '!' || line[1] == '#'))
+            line.erase(0, 1);
+
+        if (!line.empty() && line.back() == '/')
+        {
+            rule.dirOnly = true;
+            line.pop_back();
+        }
+        if (line.empty())
+            continue;
+
+        rule.anchored = line.find('/') != std::string::npos;
+        if (line[0] == '/')
+            line.erase(0, 1);
+
+        if (line.find_first_of("*?[\\") == std::string::npos)
+            rule.kind = RuleKind::Literal;
+        else if (!rule.anchored && line.size() > 1 && line[0] == '*' && line.find_first_of("*?[\\", 1) == std::string::npos)
+        {
+            rule.kind = RuleKind::Extension;
+            line.erase(0, 1);
+        }
+
+        rule.pattern = std::move(line);
+        rules.push_back(std::move(rule));
+    }
+}
+
+void IgnoreEngine::ApplyRules(const std::vector<IgnoreRule> &rules, const std::string &relativePath, bool isDir, bool &ignored)
+{
+    for (const auto &rule : rules)
+    {
+        if (rule.negated != ignored)
+            continue;
+        if (MatchRule(rule, relativePath, isDir))
+            ignored = !rule.negated;
+    }
+}
+
+bool IgnoreEngine::MatchRule(const IgnoreRule &rule, const std::string &relativePath, bool isDir)
+{
+    if (rule.dirOnly && !isDir)
+        return false;
+
+    const char *subject = relativePath.c_str();
+    size_t subjectLength = relativePath.size();
+    if (!rule.anchored)
+    {
+        size_t lastSeparator = relativePath.rfind('/');
+        if (lastSeparator != std::string::npos)
+        {
+            subject += lastSeparator + 1;
+            subjectLength -= lastSeparator + 1;
+        }
+    }
+
+    switch (rule.kind)
+    {
+    case RuleKind::Literal:
+        return subjectLength == rule.pattern.size() && std::memcmp(subject, rule.pattern.data(), subjectLength) == 0;
+    case RuleKind::Extension:
+        return subjectLength >= rule.pattern.size() &&
+               std::memcmp(subject + subjectLength - rule.pattern.size(), rule.pattern.data(), rule.pattern.size()) == 0;
+    case RuleKind::Glob:
+        return MatchGlob(rule.pattern.c_str(), subject);
+    }
+    return false;
+}
+
+bool IgnoreEngine::MatchGlob(const char *pattern, const char *text)
+{
+    while (*pattern)
+    {
+        if (pattern[0] == '*' && pattern[1] == '*')
+        {
+            pattern += 2;
+            if (!*pattern)
+                return true;
+
+            if (*pattern == '/')
+            {
+                ++pattern;
+                for (const char *segment = text;;)
+                {
+                    if (MatchGlob(pattern, segment))
+                        return true;
+                    segment = std::strchr(segment, '/');
+                    if (!segment)
+                        return false;
+                    ++segment;
+                }
+            }
+
+            for (const char *rest = text;; ++rest)
+            {
+                if (MatchGlob(pattern, rest))
+                    return true;
+                if (!*rest)
+                    return false;
+            }
+        }
+
+        switch (*pattern)
+        {
+        case '*':
+            ++pattern;
+            for (const char *rest = text;; ++rest)
+            {
+                if (MatchGlob(pattern, rest))
+                    return true;
+                if (!*rest || *rest == '/')
+                    return false;
+            }
+
+        case '?':
+            if (!*text || *text == '/')
+                return false;
+            ++pattern;
+            ++text;
+            continue;
+
+        case '[':
+        {
+            const char *end = pattern + 1;
+            if (*end == '!' || *end == '^')
+                ++end;
+            if (*end == ']')
+                ++end;
+            while (*end && *end != ']')
+                ++end;
+
+            if (*end)
+            {
+                if (!*text || *text == '/')
+                    return false;
+
+                const char *cursor = pattern + 1;
+                bool negate = *cursor == '!' || *cursor == '^';
+                if (negate)
+                    ++cursor;
+
+                bool matched = false;
+                for (bool first = true; cursor < end; first = false)
+                {
+                    if (!first && *cursor == ']')
+                        break;
+                    if (cursor + 2 < end && cursor[1] == '-')
+                    {
+                        matched |= *text >= cursor[0] && *text <= cursor[2];
+                        cursor += 3;
+                    }
+                    else
+                        matched |= *text == *cursor++;
+                }
+
+                if (matched == negate)
+                    return false;
+                pattern = end + 1;
+                ++text;
+                continue;
+            }
+            break;
+        }
+
+        case '\\':
+            if (pattern[1])
+                ++pattern;
+            break;
+        }
+
+        if (*pattern != *text)
+            return false;
+        ++pattern;
+        ++text;
+    }
+    return !*text;
+}
@@ -12,6 +12,7 @@
 #include <fstream>
 #include <wx/log.h>
 #include <functional>
+#include <algorithm>
 #include <wx/msgdlg.h>
 #include <wx/filename.h>
 #include <wx/window.h>
@@ -30,6 +31,7 @@ LanguagesPreferences &LanguagesPreferences::Get()
 LanguagesPreferences::LanguagesPreferences()
 {
     LoadExtensionsList();
+    BuildLanguageFileTable();
 }
 
 void LanguagesPreferences::LoadExtensionsList()
@@ -55,6 +57,82 @@ void LanguagesPreferences::LoadExtensionsList()
     }
 }
 
+void LanguagesPreferences::BuildLanguageFileTable()
+{
+    auto ReadIconPath = [](const std::string &languageId) -> wxString
+    {
+        wxString preferencesPath = ApplicationPaths::GetLanguagePreferencesPath(languageId) + "preferences.json";
+        if (!wxFileExists(preferencesPath))
+            return wxEmptyString;
+
+        try
+        {
+            std::ifstream preferencesFile(preferencesPath.ToStdString());
+            json preferences = json::parse(preferencesFile);
+            if (preferences.contains("icon_file_name"))
+                return ApplicationPaths::GetLanguageIcon(wxString(preferences["icon_file_name"].template get<std::string>()));
+        }
+        catch (const json::exception &e)
+        {
+            wxLogError(ERROR_JSON_PARSE_FAILED, e.what());
+        }
+        return wxEmptyString;
+    };
+
+    m_defaultFileInfo.languageId = "default";
+    m_defaultFileInfo.iconPath = ReadIconPath("default");
+    if (m_defaultFileInfo.iconPath.IsEmpty())
+        m_defaultFileInfo.iconPath = ApplicationPaths::GetLanguageIcon("unknown");
+
+    std::unordered_map<std::string, wxString> iconByLanguage;
+    for (const auto &[extension, languageId] : m_extToLang)
+    {
+        auto icon = iconByLanguage.find(languageId);
+        if (icon == iconByLanguage.end())
+            icon = iconByLanguage.emplace(languageId, ReadIconPath(languageId)).first;
+
+        if (icon->second.IsEmpty())
+            m_fileInfoByExt.emplace(extension, languageFileInfoStruct{"default", m_defaultFileInfo.iconPath});
+        else
+            m_fileInfoByExt.emplace(extension, languageFileInfoStruct{languageId, icon->second});
+    }
+}
+
+const languageFileInfoStruct &LanguagesPreferences::GetLanguageFileInfo(const wxString &path) const
+{
+    constexpr size_t maxExtensionLength = 16;
+
+    const size_t length = path.length();
+    size_t dot = length;
+    for (size_t i = length; i > 0; --i)
+    {
+        wxUniChar character = path[i - 1];
+        if (character == '/' || character == '\\')
+            break;
+        if (character == '.')
+        {
+            dot = i - 1;
+            break;
+        }
+    }
+
+    if (dot == length || dot == 0 || path[dot - 1] == '/' || path[dot - 1] == '\\' || length - dot > maxExtensionLength)
+        return m_defaultFileInfo;
+
+    char extension[maxExtensionLength];
+    size_t extensionLength = 0;
+    for (size_t i = dot; i < length; ++i)
+    {
+        wxUniChar character = path[i];
+        if (!character.IsAscii())
+            return m_defaultFileInfo;
+        extension[extensionLength++] = (char)character;
+    }
+
+    auto info = m_fileInfoByExt.find(std::string_view(extension, extensionLength));
+    return info != m_fileInfoByExt.end() ? info->second : m_defaultFileInfo;
+}
+
 languagePreferencesStruct LanguagesPreferences::SetupLanguagesPreferences(wxWindow *codeContainer)
 {
     try
@@ -75,7 +153,6 @@ languagePreferencesStruct LanguagesPreferences::SetupLanguagesPreferences(wxWind
 
         ApplyLexerStyles(currentLanguagePreferences, editor);
         SetupReservedWords(currentLanguagePreferences, editor);
-        SetupAutoCompleteWords(currentLanguagePreferences, editor);
         SetupFold(currentLanguagePreferences, editor);
         UpdateStatusBar(currentLanguagePreferences);
 
@@ -268,45 +345,37 @@ std::vector<wxString> LanguagesPreferences::GetAutoCompleteWordsList(const langu
     std::vector<wxString> autoCompleteWordsList;
     if (currentLanguagePreferences.preferences.contains("syntax"))
     {
-        auto syntaxPreferences = currentLanguagePreferences.preferences["syntax"];
+        const auto &syntaxPreferences = currentLanguagePreferences.preferences["syntax"];
         if (syntaxPreferences.contains("keyword_lists"))
         {
+            // Each list is a single space separated string of keywords
             for (auto &[listId, listWords] : syntaxPreferences["keyword_lists"].items())
-                autoCompleteWordsList.push_back(listWords.template get<std::string>());
+            {
+                for (auto &word : wxSplit(wxString::FromUTF8(listWords.template get<std::string>()), ' '))
+                    if (!word.IsEmpty())
+                        autoCompleteWordsList.push_back(word);
+            }
         }
     }
+
+    std::sort(autoCompleteWordsList.begin(), autoCompleteWordsList.end());
+    autoCompleteWordsList.erase(std::unique(autoCompleteWordsList.begin(), autoCompleteWordsList.end()), autoCompleteWordsList.end());
     return autoCompleteWordsList;
 }
 
-void LanguagesPreferences::SetupAutoCompleteWords(
-    const languagePreferencesStruct &currentLanguagePreferences,
-    wxStyledTextCtrl *editor)
+std::shared_ptr<const CompletionIndex> LanguagesPreferences::GetCompletionIndex(const languagePreferencesStruct &currentLanguagePreferences)
 {
-    if (!currentLanguagePreferences.preferences.contains("syntax"))
-        return;
+    auto cached = m_completionIndexes.find(currentLanguagePreferences.name);
+    if (cached != m_completionIndexes.end())
+        return cached->second;
 
-    auto syntaxPreferences = currentLanguagePreferences.preferences["syntax"];
-    if (!syntaxPreferences.contains("keyword_lists"))
-        return;
+    std::vector<std::string> words;
+    for (auto &word : GetAutoCompleteWordsList(currentLanguagePreferences))
+        words.push_back(word.utf8_string());
 
-    std::vector<wxString> allKeywords;
-    for (auto &[listId, listWords] : syntaxPreferences["keyword_lists"].items())
-    {
-        wxString words = wxString::FromUTF8(listWords.get<std::string>());
-        wxArrayString split = wxSplit(words, ' ');
-        for (auto &w : split)
-            if (!w.IsEmpty())
-                allKeywords.push_back(w);
-    }
-
-    editor->AutoCompSetIgnoreCase(true);
-    editor->AutoCompSetAutoHide(false);
-    editor->AutoCompSetChooseSingle(true);
-    editor->AutoCompSetFillUps("()[]{}.,:;+-*/%&|^~=<>!?\\\"'");
-    editor->AutoCompSetDropRestOfWord(true);
-    editor->AutoCompSetSeparator(' ');
-    editor->AutoCompSetMaxHeight(10);
-    editor->AutoCompSetMaxWidth(400);
+    auto index = std::make_shared<const CompletionIndex>(std::move(words));
+    m_completionIndexes.emplace(currentLanguagePreferences.name, index);
+    return index;
 }
 
 void LanguagesPreferences::UpdateStatusBar(const languagePreferencesStruct &currentLanguagePreferences)
@@ -316,14 +385,9 @@ void LanguagesPreferences::UpdateStatusBar(const languagePreferencesStruct &curr
         statusBar->UpdateLanguage(currentLanguagePreferences);
 }
 
-wxString LanguagesPreferences::GetLanguageIconPath(const wxString &path)
+const wxString &LanguagesPreferences::GetLanguageIconPath(const wxString &path) const
 {
-    auto currentLanguagePreferences = GetLanguagePreferences(path).preferences;
-
-    if (currentLanguagePreferences.contains("icon_file_name"))
-        return ApplicationPaths::GetLanguageIcon(wxString(currentLanguagePreferences["icon_file_name"].template get<std::string>()));
-    else
-        return ApplicationPaths::GetLanguageIcon("unknown");
+    return GetLanguageFileInfo(path).iconPath;
 }
 
 void LanguagesPreferences::ApplyLexerStyles(const languagePreferencesStruct &currentLanguagePreferences, wxStyledTextCtrl *editor)
@@ -278,4 +278,5 @@ RequestedSetting<T> UserSettingsManager::GetSetting(const std::string &path)
 template RequestedSetting<bool> UserSettingsManager::GetSetting<bool>(const std::string &);
 template RequestedSetting<int> UserSettingsManager::GetSetting<int>(const std::string &);
 template RequestedSetting<std::string> UserSettingsManager::GetSetting<std::string>(const std::string &);
-template RequestedSetting<double> UserSettingsManager::GetSetting<double>(const std::string &);
\ No newline at end of file
+template RequestedSetting<double> UserSettingsManager::GetSetting<double>(const std::string &);
+template RequestedSetting<std::vector<std::string>> UserSettingsManager::GetSetting<std::vector<std::string>>(const std::string &);
\ No newline at end of file
@@ -4,9 +4,13 @@
 #include "appConstants/appConstants.hpp"
 #include "languagesPreferences/languagesPreferences.hpp"
 #include "frameFileDropTarget/frameFileDropTarget.hpp"
+#include "fileOperations/fileOperations.hpp"
+#include "autoSaveWriter/autoSaveWriter.hpp"
+#include "gui/panels/filesTree/filesTree.hpp"
 
 #include <wx/filename.h>
 #include <wx/stc/stc.h>
+#include <algorithm>
 
 CodeContainer::CodeContainer(wxWindow *parent, wxString path) : wxPanel(parent, wxID_ANY, wxDefaultPosition)
 {
@@ -19,6 +23,10 @@ CodeContainer::CodeContainer(wxWindow *parent, wxString path) : wxPanel(parent,
     sizer->Add(editor, 1, wxEXPAND);
     
     SetSizerAndFit(sizer);
+
+    loadProgressTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &CodeContainer::OnLoadProgressTimer, this, loadProgressTimer.GetId());
+
     LoadPath(path);
     Layout();
 
@@ -36,6 +44,12 @@ CodeContainer::CodeContainer(wxWindow *parent, wxString path) : wxPanel(parent,
     SetAcceleratorTable(accel);
 }
 
+CodeContainer::~CodeContainer()
+{
+    loadProgressTimer.Stop();
+    DocumentLoader::Cancel(loadTask, editor);
+}
+
 void CodeContainer::LoadPath(wxString path)
 {
     wxFileName file_props(path);
@@ -47,29 +61,31 @@ void CodeContainer::LoadPath(wxString path)
 
         editor->SetLabel(path + "_codeEditor");
         editor->SetName(path);
+
+        DocumentLoader::Cancel(loadTask, editor);
+        loadTask.reset();
+
+        // The background load swaps the document without modification events, uncount its words first
+        editor->AttachWordIndex(nullptr);
+
+        // Known before loading, so a huge file is never styled
+        const wxULongLong size = file_props.GetSize();
+        editor->SetLargeFileMode(IsLargeFile(size, 0));
+
+        if (size != wxInvalidSize && size >= BACKGROUND_LOAD_BYTES && StartBackgroundLoad(path))
+        {
+            statusBar->UpdateComponents(path);
+            GetParent()->Layout();
+            Layout();
+            return;
+        }
+
         editor->LoadFile(path);
-        
-        statusBar->UpdateComponents(path);
-
-        languagePreferences = LanguagesPreferences::Get().SetupLanguagesPreferences(this);
-
-        editor->SetAutoCompleteWordsList(LanguagesPreferences::Get().GetAutoCompleteWordsList(languagePreferences));
-        editor->SetLanguagesPreferences(languagePreferences);
-
-        Save(path);
-        editor->SendMsg(4003, 0, -1);
-        
-        wxStyledTextCtrlMiniMap* minimap = new wxStyledTextCtrlMiniMap(this, editor);
-        minimap->SetSize(wxSize(100, minimap->GetSize().y));
-        minimap->SetMinSize(wxSize(100, minimap->GetSize().y));
-        
-        sizer->Add(minimap,  0 ,wxEXPAND);
-        
-        if (!UserSettingsManager::Get().GetSetting<bool>("editor/showMinimap").value)
-        minimap->Hide();
-        
-        minimap->SetLabel(path + "_codeMap");
-        minimap->SetName(path);
+
+        // Opening a file never writes it, the hash lets an unchanged document skip the next save too
+        editor->SetSavedContent(editor->GetContentHash(), editor->GetContentLength());
+        OnDocumentLoaded();
+        return;
     }
     else
     {
@@ -80,6 +96,144 @@ void CodeContainer::LoadPath(wxString path)
     Layout();
 }
 
+void CodeContainer::OnDocumentLoaded()
+{
+    const wxString path = currentPath;
+
+    if (!editor->IsLargeFileMode() && IsLargeFile(0, editor->GetLineCount()))
+        editor->SetLargeFileMode(true);
+
+    statusBar->UpdateComponents(path);
+
+    if (editor->IsLargeFileMode())
+    {
+        GetParent()->Layout();
+        Layout();
+        return;
+    }
+
+    languagePreferences = LanguagesPreferences::Get().SetupLanguagesPreferences(this);
+
+    editor->SetCompletionIndex(LanguagesPreferences::Get().GetCompletionIndex(languagePreferences));
+    editor->AttachWordIndex(BufferWordIndex::ForLanguage(languagePreferences.name));
+    editor->SetLanguagesPreferences(languagePreferences);
+
+    editor->SendMsg(4003, 0, -1);
+    
+    wxStyledTextCtrlMiniMap* minimap = new wxStyledTextCtrlMiniMap(this, editor);
+    minimap->SetSize(wxSize(100, minimap->GetSize().y));
+    minimap->SetMinSize(wxSize(100, minimap->GetSize().y));
+    
+    sizer->Add(minimap,  0 ,wxEXPAND);
+    
+    if (!UserSettingsManager::Get().GetSetting<bool>("editor/showMinimap").value)
+    minimap->Hide();
+    
+    minimap->SetLabel(path + "_codeMap");
+    minimap->SetName(path);
+
+    GetParent()->Layout();
+    Layout();
+}
+
+bool CodeContainer::StartBackgroundLoad(const wxString &path)
+{
+    loadTask = DocumentLoader::Start(editor, path, editor->IsLargeFileMode(),
+                                     [this](std::shared_ptr<DocumentLoadTask> task)
+                                     { OnBackgroundLoadFinished(task); });
+    if (!loadTask)
+        return false;
+
+    editor->SetReadOnly(true);
+    loadProgressTimer.Start(100);
+
+    if (auto tabs = ((Tabs *)FindWindowById(+GUI::ControlID::Tabs)))
+        tabs->SetLoadingProgress(path, 0);
+    return true;
+}
+
+void CodeContainer::OnBackgroundLoadFinished(std::shared_ptr<DocumentLoadTask> task)
+{
+    if (task != loadTask)
+        return;
+
+    loadTask.reset();
+    loadProgressTimer.Stop();
+
+    if (auto tabs = ((Tabs *)FindWindowById(+GUI::ControlID::Tabs)))
+        tabs->SetLoadingProgress(currentPath, -1);
+
+    void *document = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        std::swap(document, task->document);
+    }
+
+    editor->SetReadOnly(false);
+
+    if (task->failed || !document)
+    {
+        pendingActions.clear();
+        wxMessageBox(_("There was an error opening the file"), _("Error"), wxICON_ERROR);
+        return;
+    }
+
+    // Indentation settings belong to the document, carry them over to the loaded one
+    const int indent = editor->GetIndent();
+    const int tabWidth = editor->GetTabWidth();
+    const bool useTabs = editor->GetUseTabs();
+    const bool tabIndents = editor->GetTabIndents();
+    const bool backSpaceUnIndents = editor->GetBackSpaceUnIndents();
+
+    editor->SetDocPointer(document);
+    editor->ReleaseDocument(document);
+
+    editor->SetCodePage(wxSTC_CP_UTF8);
+    editor->SetIndent(indent);
+    editor->SetTabWidth(tabWidth);
+    editor->SetUseTabs(useTabs);
+    editor->SetTabIndents(tabIndents);
+    editor->SetBackSpaceUnIndents(backSpaceUnIndents);
+    editor->EmptyUndoBuffer();
+    editor->SetSavePoint();
+    editor->SetSavedContent(task->contentHash, editor->GetContentLength());
+
+    OnDocumentLoaded();
+
+    std::vector<std::function<void()>> actions;
+    actions.swap(pendingActions);
+    for (auto &action : actions)
+        action();
+}
+
+void CodeContainer::OnLoadProgressTimer(wxTimerEvent &WXUNUSED(event))
+{
+    if (!loadTask || loadTask->totalBytes == 0)
+        return;
+
+    const int percent = (int)(loadTask->loadedBytes * 100 / loadTask->totalBytes);
+    if (auto tabs = ((Tabs *)FindWindowById(+GUI::ControlID::Tabs)))
+        tabs->SetLoadingProgress(currentPath, std::min(percent, 99));
+}
+
+void CodeContainer::RunWhenLoaded(std::function<void()> action)
+{
+    if (IsLoading())
+        pendingActions.push_back(std::move(action));
+    else
+        action();
+}
+
+bool CodeContainer::IsLargeFile(wxULongLong bytes, int lines)
+{
+    auto maxBytes = UserSettingsManager::Get().GetSetting<int>("editor/largeFile/maxBytes");
+    auto maxLines = UserSettingsManager::Get().GetSetting<int>("editor/largeFile/maxLines");
+
+    if (maxBytes.found && maxBytes.value > 0 && bytes != wxInvalidSize && bytes > (wxULongLong)maxBytes.value)
+        return true;
+    return maxLines.found && maxLines.value > 0 && lines > maxLines.value;
+}
+
 void CodeContainer::OnSave(wxCommandEvent &WXUNUSED(event))
 {
     Save(ProjectSettings::Get().GetCurrentlyFileOpen());
@@ -89,24 +243,42 @@ bool CodeContainer::Save(wxString path)
 {
     auto currentEditor = ((Editor *)wxFindWindowByLabel(path + "_codeEditor"));
 
+    // The content of a file still loading is incomplete, it must never overwrite the file
+    auto currentContainer = currentEditor ? dynamic_cast<CodeContainer *>(currentEditor->GetParent()) : nullptr;
+    if (currentContainer && currentContainer->IsLoading())
+        return false;
+
     if (currentEditor)
     {
-        if (currentEditor->SaveFile(path) && !currentEditor->Modified())
+        const char *content = currentEditor->GetCharacterPointer();
+        const size_t length = currentEditor->GetContentLength();
+        const uint64_t hash = FileOperations::ContentHash(content, length);
+
+        // An autosaved copy still queued is older than this content
+        AutoSaveWriter::Get().Discard(path);
+
+        // Unchanged bytes are not written again, the file keeps its modification time
+        bool saved = path == currentEditor->GetName() && currentEditor->IsSavedContent(hash, length) && wxFileExists(path);
+        if (!saved)
         {
-            if (auto tab = FindWindowByLabel(path + "_tab"))
-            {
-                auto icon = ((wxStaticBitmap *)tab->GetChildren()[0]->GetChildren()[2]);
-                if (icon)
-                {
-                    icon->SetBitmap(wxBitmapBundle::FromBitmap(wxBitmap(ApplicationPaths::AssetsPath("icons") + "close.png", wxBITMAP_TYPE_PNG)));
-                    icon->SetLabel("saved_icon");
-                    tab->Layout();
-                }
-            }
+            size_t bytesWritten = 0;
+            saved = FileOperations::WriteFileAtomically(path, content, length, &bytesWritten);
+            if (saved)
+                wxLogStatus("Saved %zu bytes to '%s'", bytesWritten, path);
+        }
+
+        if (saved)
+        {
+            currentEditor->SetSavedContent(hash, length);
+            currentEditor->MarkSaved();
+            if (statusBar)
+                statusBar->UpdateAutoSaveError(path, false);
 
             if (path == UserSettingsManager::Get().SettingsPath)
             {
                 UserSettingsManager::Get().LoadSettingsFromFile();
+                if (auto filesTree = ((FilesTree *)FindWindowById(+GUI::ControlID::FilesTree)))
+                    filesTree->ReloadIgnoreRules();
             }
 
             if(path == ShortCutSettingsManager::Get().ShortcutsPath)
@@ -165,13 +337,8 @@ void CodeContainer::OnCloseFile(wxCommandEvent &WXUNUSED(event))
             if (wxMessageBox(_("Text is not saved, save before closing?"), _("Close"),
                              wxYES_NO | wxICON_QUESTION) == wxYES)
             {
-                currentEditor->SaveFile();
-                if (currentEditor->Modified())
-                {
-                    wxMessageBox(_("Text could not be saved!"), _("Close abort"),
-                                 wxOK | wxICON_EXCLAMATION);
+                if (!Save(currentEditor->GetName()))
                     return;
-                }
             }
         }
 
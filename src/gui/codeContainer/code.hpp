@@ -16,6 +16,7 @@
 #include <wx/stc/minimap.h>
 
 #include "./editor/editor.hpp"
+#include "./documentLoader/documentLoader.hpp"
 
 #include "gui/panels/tabs/tabs.hpp"
 #include "gui/widgets/statusBar/statusBar.hpp"
@@ -23,6 +24,10 @@
 
 #include <wx/stc/stc.h>
 #include <wx/scrolwin.h>
+#include <wx/timer.h>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /**
  * @class CodeContainer
@@ -47,16 +52,36 @@ public:
      */
     CodeContainer(wxWindow *parent, wxString path);
 
+    /**
+     * @brief Cancels a background load still running.
+     */
+    ~CodeContainer();
+
     /**
      * @brief Loads a file into the editor and minimap.
      *
      * This replaces the current editor content with the contents of the file
-     * located at the given path.
+     * located at the given path. Files of at least BACKGROUND_LOAD_BYTES are
+     * read on a worker thread, the editor stays read-only until they are loaded.
      *
      * @param path File path to load.
      */
     void LoadPath(wxString path);
 
+    /**
+     * @brief Tells whether the file is still being loaded in the background.
+     */
+    bool IsLoading() const { return loadTask != nullptr; }
+
+    /**
+     * @brief Runs an action once the file is loaded, immediately if it already is.
+     *
+     * Used for actions depending on the content, such as moving to a line.
+     *
+     * @param action The action to run.
+     */
+    void RunWhenLoaded(std::function<void()> action);
+
     // -------------------------------------------------------------------------
     // File operations
     // -------------------------------------------------------------------------
@@ -145,6 +170,47 @@ public:
     wxString currentPath; /**< Currently opened file path. */
     Editor *editor;       /**< Main code editor instance. */
 private:
+    /**
+     * @brief Tells whether a file exceeds the large-file thresholds of the user settings.
+     *
+     * Reads `editor/largeFile/maxBytes` and `editor/largeFile/maxLines`, a
+     * threshold of 0 disables the corresponding check.
+     *
+     * @param bytes Size of the file in bytes.
+     * @param lines Number of lines of the file, 0 if not known yet.
+     * @return true if the file must be opened in large-file mode.
+     */
+    static bool IsLargeFile(wxULongLong bytes, int lines);
+
+    /**
+     * @brief Starts loading the file on a worker thread.
+     * @param path File path to load.
+     * @return false if the editor cannot load in the background, the file must then be loaded directly.
+     */
+    bool StartBackgroundLoad(const wxString &path);
+
+    /**
+     * @brief Attaches the document produced by a background load to the editor.
+     * @param task The finished load.
+     */
+    void OnBackgroundLoadFinished(std::shared_ptr<DocumentLoadTask> task);
+
+    /**
+     * @brief Shows the progress of the background load on the tab.
+     */
+    void OnLoadProgressTimer(wxTimerEvent &WXUNUSED(event));
+
+    /**
+     * @brief Sets up language, minimap and status bar once the editor holds the file content.
+     */
+    void OnDocumentLoaded();
+
+    static constexpr unsigned long long BACKGROUND_LOAD_BYTES = 2 * 1024 * 1024; /**< Files from this size on are loaded in the background. */
+
+    std::shared_ptr<DocumentLoadTask> loadTask;                                       /**< Background load in progress, if any. */
+    wxTimer loadProgressTimer;                                                        /**< Refreshes the loading progress shown on the tab. */
+    std::vector<std::function<void()>> pendingActions;                                /**< Actions waiting for the background load to finish. */
+
     wxString iconsDir = ApplicationPaths::AssetsPath("icons");                        /**< Directory containing editor icons. */
     wxFont font;                                                                      /**< Editor font. */
     wxStyledTextCtrlMiniMap* minimap;                                                                 /**< Minimap instance. */
@@ -1,7 +1,7 @@
 #include "codeSearch.hpp"
 #include "ui/ids.hpp"
 
-Search::Search(wxWindow *parent, const wxString &defaultLabel, wxStyledTextCtrl *editor)
+Search::Search(wxWindow *parent, const wxString &defaultLabel, Editor *editor)
     : wxPanel(parent, +GUI::ControlID::CodeSearch, wxPoint(parent->GetSize().GetWidth() - 360, 50), wxSize(250, 35)),
       m_input(nullptr),
       m_editor(editor)
@@ -40,9 +40,9 @@ Search::Search(wxWindow *parent, const wxString &defaultLabel, wxStyledTextCtrl
 
     if (m_editor)
     {
-        m_editor->IndicatorSetStyle(SEARCH_INDICATOR, wxSTC_INDIC_ROUNDBOX);
-        m_editor->IndicatorSetForeground(SEARCH_INDICATOR, wxColour(255, 80, 80));
-        m_editor->IndicatorSetAlpha(SEARCH_INDICATOR, 80);
+        m_editor->IndicatorSetStyle(EditorConstants::SEARCH_INDICATOR, wxSTC_INDIC_ROUNDBOX);
+        m_editor->IndicatorSetForeground(EditorConstants::SEARCH_INDICATOR, wxColour(255, 80, 80));
+        m_editor->IndicatorSetAlpha(EditorConstants::SEARCH_INDICATOR, 80);
     }
 
     if (!defaultLabel.IsEmpty())
@@ -54,7 +54,7 @@ Search::Search(wxWindow *parent, const wxString &defaultLabel, wxStyledTextCtrl
 Search::~Search()
 {
     if (m_editor)
-        m_editor->IndicatorClearRange(0, m_editor->GetLength());
+        m_editor->ClearIndicator(EditorConstants::SEARCH_INDICATOR);
 }
 
 void Search::OnChar(wxStyledTextEvent &event)
@@ -78,7 +78,7 @@ void Search::DoSearch(bool forward)
     wxString query = m_input->GetText();
     int length = m_editor->GetLength();
 
-    m_editor->IndicatorClearRange(0, length);
+    m_editor->ClearIndicator(EditorConstants::SEARCH_INDICATOR);
 
     if (query.IsEmpty())
         return;
@@ -95,7 +95,7 @@ void Search::DoSearch(bool forward)
         if (pos == -1)
             break;
 
-        m_editor->IndicatorFillRange(pos, query.Length());
+        m_editor->FillIndicator(EditorConstants::SEARCH_INDICATOR, pos, query.Length());
         m_editor->SetTargetStart(pos + query.Length());
         m_editor->SetTargetEnd(length);
     }
@@ -111,7 +111,7 @@ void Search::DoSearch(bool forward)
 void Search::Close(wxCommandEvent &)
 {
     if (m_editor)
-        m_editor->IndicatorClearRange(0, m_editor->GetLength());
+        m_editor->ClearIndicator(EditorConstants::SEARCH_INDICATOR);
 
     Destroy();
 }
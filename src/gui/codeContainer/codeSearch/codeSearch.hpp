@@ -3,6 +3,7 @@
 #include <wx/wx.h>
 #include <wx/stc/stc.h>
 #include <themesManager/themesManager.hpp>
+#include "gui/codeContainer/editor/editor.hpp"
 
 /**
  * @class Search
@@ -27,9 +28,9 @@ public:
      * @brief Constructs the search panel.
      *
      * @param parent Parent window.
-     * @param editor Target wxStyledTextCtrl where search is performed.
+     * @param editor Target editor where search is performed.
      */
-    explicit Search(wxWindow *parent, const wxString &defaultLabel, wxStyledTextCtrl *editor);
+    explicit Search(wxWindow *parent, const wxString &defaultLabel, Editor *editor);
 
     /**
      * @brief Destructor. Clears search indicators.
@@ -70,9 +71,7 @@ private:
 
 private:
     wxStyledTextCtrl *m_input;
-    wxStyledTextCtrl *m_editor;
+    Editor *m_editor;
 
     wxColour m_borderColor = ThemesManager::Get().GetColor("border");
-
-    static constexpr int SEARCH_INDICATOR = 8;
 };
@@ -0,0 +1,228 @@
+#include "documentLoader.hpp"
+
+#include "mappedFile/mappedFile.hpp"
+#include "fileOperations/fileOperations.hpp"
+
+#include <wx/filename.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#ifdef __WXMSW__
+#define KRAFTA_SCI_METHOD __stdcall
+#else
+#define KRAFTA_SCI_METHOD
+#endif
+
+namespace
+{
+    /**
+     * @brief Layout of Scintilla's ILoader, the object returned by SCI_CREATELOADER.
+     *
+     * wxWidgets does not ship ILoader.h, the vtable is declared here in the
+     * same order so the pointer can be used directly.
+     */
+    class ScintillaLoader
+    {
+    public:
+        virtual int KRAFTA_SCI_METHOD Release() = 0;
+        virtual int KRAFTA_SCI_METHOD AddData(const char *data, ptrdiff_t length) = 0;
+        virtual void *KRAFTA_SCI_METHOD ConvertToDocument() = 0;
+    };
+
+    constexpr size_t LOADER_CHUNK_BYTES = 1024 * 1024; ///< Bytes handed to the loader between two cancellation checks
+    constexpr int LOADER_STATUS_OK = 0;                ///< SC_STATUS_OK
+
+    /**
+     * @brief Streams a mapped file into a loader.
+     * @return False if the loader rejected the data (usually out of memory).
+     */
+    bool FeedLoader(ScintillaLoader *loader, const MappedFile &file, DocumentLoadTask &task, uint64_t &hash)
+    {
+        hash = FileOperations::ContentHash(nullptr, 0);
+
+        const char *data = file.GetData();
+        const size_t size = file.GetSize();
+
+        size_t position = 0;
+        if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+            position = 3;
+
+        while (position < size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(task.mutex);
+                if (task.cancelled)
+                    return true;
+            }
+
+            const size_t end = std::min(position + LOADER_CHUNK_BYTES, size);
+            while (position < end)
+            {
+                bool truncated = false;
+                size_t valid = DocumentLoader::ValidUtf8Prefix(data + position, end - position, truncated);
+                if (valid > 0)
+                {
+                    if (loader->AddData(data + position, (ptrdiff_t)valid) != LOADER_STATUS_OK)
+                        return false;
+                    hash = FileOperations::ContentHash(data + position, valid, hash);
+                    position += valid;
+                }
+
+                if (position >= end)
+                    break;
+
+                // A sequence cut by the chunk boundary is checked again with the next chunk
+                if (truncated && end < size)
+                    break;
+
+                // Invalid byte, decoded as Latin-1 so the content is still shown
+                const unsigned char byte = (unsigned char)data[position];
+                const char encoded[2] = {(char)(0xC0 | (byte >> 6)), (char)(0x80 | (byte & 0x3F))};
+                if (loader->AddData(encoded, 2) != LOADER_STATUS_OK)
+                    return false;
+                hash = FileOperations::ContentHash(encoded, 2, hash);
+                ++position;
+            }
+
+            task.loadedBytes = position;
+        }
+        return true;
+    }
+}
+
+namespace DocumentLoader
+{
+    size_t ValidUtf8Prefix(const char *data, size_t length, bool &truncated)
+    {
+        truncated = false;
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+
+        size_t i = 0;
+        while (i < length)
+        {
+            // Skip ASCII eight bytes at a time
+            if (i + 8 <= length)
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                if ((word & 0x8080808080808080ULL) == 0)
+                {
+                    i += 8;
+                    continue;
+                }
+            }
+
+            const unsigned char lead = bytes[i];
+            if (lead < 0x80)
+            {
+                ++i;
+                continue;
+            }
+
+            size_t continuation;
+            unsigned char low = 0x80, high = 0xBF;
+            if (lead >= 0xC2 && lead <= 0xDF)
+                continuation = 1;
+            else if (lead == 0xE0)
+                continuation = 2, low = 0xA0;
+            else if (lead == 0xED)
+                continuation = 2, high = 0x9F;
+            else if (lead >= 0xE1 && lead <= 0xEF)
+                continuation = 2;
+            else if (lead == 0xF0)
+                continuation = 3, low = 0x90;
+            else if (lead == 0xF4)
+                continuation = 3, high = 0x8F;
+            else if (lead >= 0xF1 && lead <= 0xF3)
+                continuation = 3;
+            else
+                return i;
+
+            for (size_t k = 1; k <= continuation; ++k)
+            {
+                if (i + k >= length)
+                {
+                    truncated = true;
+                    return i;
+                }
+
+                const unsigned char byte = bytes[i + k];
+                if (k == 1 ? (byte < low || byte > high) : (byte < 0x80 || byte > 0xBF))
+                    return i;
+            }
+            i += continuation + 1;
+        }
+        return i;
+    }
+
+    std::shared_ptr<DocumentLoadTask> Start(wxStyledTextCtrl *editor, const wxString &path, bool largeFile, Handler onFinished)
+    {
+        const wxULongLong size = wxFileName::GetSize(path);
+        if (size == wxInvalidSize)
+            return nullptr;
+
+        int options = wxSTC_DOCUMENTOPTION_DEFAULT;
+        if (largeFile)
+            options |= wxSTC_DOCUMENTOPTION_STYLES_NONE;
+        if (size > wxULongLong(INT_MAX))
+            options |= wxSTC_DOCUMENTOPTION_TEXT_LARGE;
+
+        // The size is only a hint to preallocate the buffer
+        const int hint = size > wxULongLong(INT_MAX) ? INT_MAX : (int)size.GetValue();
+        auto loader = static_cast<ScintillaLoader *>(editor->CreateLoader(hint, options));
+        if (!loader)
+            return nullptr;
+
+        auto task = std::make_shared<DocumentLoadTask>();
+        task->totalBytes = (size_t)size.GetValue();
+
+        std::thread([editor, task, loader, path, onFinished]()
+                    {
+            MappedFile file;
+            uint64_t hash = 0;
+            bool failed = !file.Open(path) || !FeedLoader(loader, file, *task, hash);
+            file.Close();
+
+            std::lock_guard<std::mutex> lock(task->mutex);
+            if (task->cancelled || failed)
+            {
+                loader->Release();
+                if (task->cancelled)
+                    return;
+                task->failed = true;
+            }
+            else
+            {
+                task->document = loader->ConvertToDocument();
+                task->contentHash = hash;
+                task->loadedBytes = task->totalBytes;
+            }
+
+            editor->CallAfter([task, onFinished]()
+                              {
+                if (!task->cancelled)
+                    onFinished(task); }); })
+            .detach();
+
+        return task;
+    }
+
+    void Cancel(const std::shared_ptr<DocumentLoadTask> &task, wxStyledTextCtrl *editor)
+    {
+        if (!task)
+            return;
+
+        void *document = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(task->mutex);
+            task->cancelled = true;
+            std::swap(document, task->document);
+        }
+
+        if (document)
+            editor->ReleaseDocument(document);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file documentLoader.hpp
+ * @brief Background loading of files into Scintilla documents.
+ */
+
+#include <wx/stc/stc.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @struct DocumentLoadTask
+ * @brief State shared between a background document load and the UI thread.
+ *
+ * The worker only publishes the document while holding the mutex and while
+ * the task is not cancelled, so whoever cancels the task under the mutex also
+ * takes over the document and must release it.
+ */
+struct DocumentLoadTask
+{
+    std::mutex mutex;                     ///< Guards cancelled and document
+    bool cancelled = false;               ///< Set when the editor is closed before the load completes
+    bool failed = false;                  ///< Set when the file could not be mapped or the document not filled
+    void *document = nullptr;             ///< Finished document (reference count 1) waiting to be attached
+    size_t totalBytes = 0;                ///< Size of the file
+    std::atomic<size_t> loadedBytes{0};   ///< Bytes already handed to Scintilla, used to show the progress
+    uint64_t contentHash = 0;             ///< FileOperations::ContentHash() of the document content, set with document
+};
+
+/**
+ * @namespace DocumentLoader
+ * @brief Fills Scintilla documents on a worker thread.
+ *
+ * The file is memory-mapped and streamed into the loader returned by
+ * `SCI_CREATELOADER`, so the UI thread never reads or converts the file. The
+ * content is checked to be UTF-8 on the way: valid sequences are copied as is
+ * and invalid bytes are decoded as Latin-1.
+ */
+namespace DocumentLoader
+{
+    /**
+     * @brief Callback receiving the finished task on the UI thread.
+     */
+    using Handler = std::function<void(std::shared_ptr<DocumentLoadTask>)>;
+
+    /**
+     * @brief Starts loading a file.
+     * @param editor The editor the document is meant for; it creates the loader and receives the callback.
+     * @param path The file path.
+     * @param largeFile Whether the document is opened in large-file mode (no style storage is allocated).
+     * @param onFinished Called on the UI thread once the document is ready or the load failed,
+     *        never called if the task was cancelled.
+     * @return The task, or nullptr if the editor does not provide a loader.
+     */
+    std::shared_ptr<DocumentLoadTask> Start(wxStyledTextCtrl *editor, const wxString &path, bool largeFile, Handler onFinished);
+
+    /**
+     * @brief Cancels a load and releases its document if it was already produced.
+     * @param task The task to cancel.
+     * @param editor The editor used to release the document.
+     */
+    void Cancel(const std::shared_ptr<DocumentLoadTask> &task, wxStyledTextCtrl *editor);
+
+    /**
+     * @brief Returns the length of the longest prefix made of complete, valid UTF-8 sequences.
+     * @param data The bytes to check.
+     * @param length Number of bytes.
+     * @param truncated Set to true when the prefix stops on a sequence cut by the end of the buffer.
+     */
+    size_t ValidUtf8Prefix(const char *data, size_t length, bool &truncated);
+}
@@ -4,7 +4,10 @@
 #include <vector>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include "gui/codeContainer/code.hpp"
+#include "fileOperations/fileOperations.hpp"
+#include "autoSaveWriter/autoSaveWriter.hpp"
 
 Editor::Editor(wxWindow *parent)
     : wxStyledTextCtrl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE)
@@ -13,6 +16,147 @@ Editor::Editor(wxWindow *parent)
     ConfigureFoldMargin();
 
     m_linked_container = (CodeContainer *)parent;
+    m_autoSaveTimer.SetOwner(this);
+}
+
+Editor::~Editor()
+{
+    AttachWordIndex(nullptr);
+}
+
+void Editor::AttachWordIndex(std::shared_ptr<BufferWordIndex> index)
+{
+    if (m_wordIndex)
+        m_wordIndex->RemoveText(GetCharacterPointer(), GetContentLength());
+
+    m_wordIndex = std::move(index);
+    m_nearbyWordsLine = -1;
+
+    if (m_wordIndex)
+        m_wordIndex->AddText(GetCharacterPointer(), GetContentLength());
+}
+
+void Editor::UpdateWordIndex(wxStyledTextEvent &event)
+{
+    const int type = event.GetModificationType();
+    if (type & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT))
+    {
+        if (event.GetLinesAdded() == 0 && LineFromPosition(event.GetPosition()) == m_nearbyWordsLine)
+            m_nearbyWordsLineChanged = true;
+        else
+            m_nearbyWordsLine = -1;
+    }
+
+    const bool before = type & (wxSTC_MOD_BEFOREINSERT | wxSTC_MOD_BEFOREDELETE);
+    if (!m_wordIndex || !(before || (type & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT))))
+        return;
+
+    // The range spans the changed text when it is in the document: before a deletion, after an insertion
+    const int position = event.GetPosition();
+    const bool spansText = (type & (wxSTC_MOD_BEFOREDELETE | wxSTC_MOD_INSERTTEXT)) != 0;
+    const int start = WordIndexBoundary(position, -1);
+    const int end = WordIndexBoundary(spansText ? position + event.GetLength() : position, 1);
+    if (end <= start)
+        return;
+
+    const wxCharBuffer text = GetTextRangeRaw(start, end);
+    if (before)
+        m_wordIndex->RemoveText(text.data(), text.length());
+    else
+        m_wordIndex->AddText(text.data(), text.length());
+}
+
+int Editor::WordIndexBoundary(int position, int direction)
+{
+    if (direction < 0)
+    {
+        while (position > 0 && BufferWordIndex::IsWordByte((unsigned char)GetCharAt(position - 1)))
+            --position;
+    }
+    else
+    {
+        const int length = GetTextLength();
+        while (position < length && BufferWordIndex::IsWordByte((unsigned char)GetCharAt(position)))
+            ++position;
+    }
+    return position;
+}
+
+void Editor::AddNearbyWords(int line, int distance)
+{
+    const wxCharBuffer text = GetLineRaw(line);
+    BufferWordIndex::ForEachWord(text.data(), text.length(), [&](std::string_view nearWord)
+                                 {
+        auto entry = m_nearbyWords.find(nearWord);
+        if (entry == m_nearbyWords.end())
+            m_nearbyWords.emplace(std::string(nearWord), distance);
+        else if (distance < entry->second)
+            entry->second = distance; });
+}
+
+const BufferWordIndex::NearbyWords &Editor::GetNearbyWords()
+{
+    const int caretLine = GetCurrentLine();
+    if (caretLine != m_nearbyWordsLine)
+    {
+        m_nearbyWords.clear();
+        m_nearbyWordsLine = caretLine;
+
+        const int firstLine = std::max(caretLine - EditorConstants::AUTOCOMPLETE_NEARBY_LINES, 0);
+        const int lastLine = std::min(caretLine + EditorConstants::AUTOCOMPLETE_NEARBY_LINES, GetLineCount() - 1);
+        for (int line = firstLine; line <= lastLine; ++line)
+            AddNearbyWords(line, std::abs(line - caretLine));
+    }
+    else if (m_nearbyWordsLineChanged)
+    {
+        AddNearbyWords(caretLine, 0);
+    }
+
+    m_nearbyWordsLineChanged = false;
+    return m_nearbyWords;
+}
+
+void Editor::BuildCompletionList(const std::string &word)
+{
+    m_completionList.clear();
+
+    std::vector<std::string_view> bufferWords;
+    if (m_wordIndex)
+    {
+        // Words written around the caret are the most likely to be typed again
+        m_wordIndex->Complete(word, GetNearbyWords(), EditorConstants::AUTOCOMPLETE_MAX_ITEMS, bufferWords);
+        for (const auto &bufferWord : bufferWords)
+        {
+            if (!m_completionList.empty())
+                m_completionList += ' ';
+            m_completionList += bufferWord;
+        }
+    }
+
+    if (!m_completionIndex || bufferWords.size() >= EditorConstants::AUTOCOMPLETE_MAX_ITEMS)
+        return;
+
+    // Keywords fill the rest of the list, without repeating a buffer word
+    std::string keywords;
+    m_completionIndex->Complete(word, EditorConstants::AUTOCOMPLETE_MAX_ITEMS, keywords, word);
+
+    size_t count = bufferWords.size();
+    for (size_t start = 0; start < keywords.size() && count < EditorConstants::AUTOCOMPLETE_MAX_ITEMS;)
+    {
+        size_t end = keywords.find(' ', start);
+        if (end == std::string::npos)
+            end = keywords.size();
+
+        std::string_view keyword(keywords.data() + start, end - start);
+        if (std::find(bufferWords.begin(), bufferWords.end(), keyword) == bufferWords.end())
+        {
+            if (!m_completionList.empty())
+                m_completionList += ' ';
+            m_completionList += keyword;
+            ++count;
+        }
+        start = end + 1;
+    }
 }
 
 void Editor::InitializePreferences()
@@ -50,6 +194,18 @@ void Editor::InitializePreferences()
     StyleSetBackground(wxSTC_STYLE_INDENTGUIDE, wxColor(backgroundColor));
     StyleSetForeground(wxSTC_STYLE_INDENTGUIDE, wxColor(secondaryTextColor));
 
+    // Every editor offers buffer words, also for languages without keyword lists
+    AutoCompSetIgnoreCase(true);
+    AutoCompSetAutoHide(false);
+    AutoCompSetChooseSingle(true);
+    AutoCompSetFillUps("()[]{}.,:;+-*/%&|^~=<>!?\\\"'");
+    AutoCompSetDropRestOfWord(true);
+    AutoCompSetSeparator(' ');
+    // Buffer words are listed by relevance, Scintilla sorts its own copy for searching
+    AutoCompSetOrder(wxSTC_ORDER_CUSTOM);
+    AutoCompSetMaxHeight(10);
+    AutoCompSetMaxWidth(400);
+
     wxAcceleratorEntry entries[] = {
         {wxACCEL_CTRL, WXK_RETURN, static_cast<int>(Event::Edit::MoveCursorDown)},
         {wxACCEL_CTRL | wxACCEL_SHIFT, WXK_RETURN, static_cast<int>(Event::Edit::MoveCursorUp)},
@@ -61,9 +217,6 @@ void Editor::InitializePreferences()
 
     SetAcceleratorTable(wxAcceleratorTable(WXSIZEOF(entries), entries));
 
-    m_AutoCompleteWordsList =
-        LanguagesPreferences::Get().GetAutoCompleteWordsList(m_LanguagePreferences);
-
     SetIndent(4);
     SetTabWidth(4);
     SetUseTabs(false);
@@ -85,6 +238,36 @@ void Editor::ConfigureFoldMargin()
                  wxSTC_FOLDFLAG_LINEBEFORE_EXPANDED);
 }
 
+void Editor::SetLargeFileMode(bool largeFileMode)
+{
+    if (m_largeFileMode == largeFileMode)
+        return;
+    m_largeFileMode = largeFileMode;
+
+    if (m_largeFileMode)
+    {
+        SetLexer(wxSTC_LEX_NULL);
+        SetProperty("fold", "0");
+        SetMarginWidth(EditorConstants::FOLD_MARGIN, 0);
+        SetMarginSensitive(EditorConstants::FOLD_MARGIN, false);
+        SetIndentationGuides(wxSTC_IV_NONE);
+        SetMarginWidth(EditorConstants::LINE_NUMBER_MARGIN,
+                       TextWidth(wxSTC_STYLE_LINENUMBER, wxT("_9999999")));
+    }
+    else
+    {
+        ConfigureFoldMargin();
+        SetIndentationGuides(wxSTC_IV_LOOKBOTH);
+        SetMarginWidth(EditorConstants::LINE_NUMBER_MARGIN,
+                       TextWidth(wxSTC_STYLE_LINENUMBER, wxT("_99999")));
+    }
+}
+
+uint64_t Editor::GetContentHash()
+{
+    return FileOperations::ContentHash(GetCharacterPointer(), GetContentLength());
+}
+
 void Editor::OnUpdateUI(wxStyledTextEvent &event)
 {
     event.Skip();
@@ -92,30 +275,250 @@ void Editor::OnUpdateUI(wxStyledTextEvent &event)
 
 void Editor::OnChange(wxStyledTextEvent &event)
 {
+    UpdateWordIndex(event);
+
+    const bool textChanged = (event.GetModificationType() & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT)) != 0;
+    if (textChanged)
+    {
+        ++m_changeCount;
+        ShiftIndicatorSpans(event.GetPosition(), (event.GetModificationType() & wxSTC_MOD_INSERTTEXT) ? event.GetLength() : -event.GetLength());
+        UpdateUnsavedIndicator();
+
+        // Also when back at the save point: queued occurrence ranges hold pre-edit offsets
+        if (!m_largeFileMode)
+            ClearIndicators();
+    }
+
     if (!GetModify())
     {
         event.Skip();
         return;
     }
 
-    if (UserSettingsManager::Get().GetSetting<bool>("editor/autoSave").value && GetName() != UserSettingsManager::Get().SettingsPath)
-    {
-        m_linked_container->Save(GetName());
-    }
-    else
+    changedFile = true;
+
+    // Every keystroke restarts the quiet period, a burst of typing is saved once
+    if (textChanged && IsAutoSaveEnabled())
     {
-        changedFile = true;
-        UpdateUnsavedIndicator();
+        auto delay = UserSettingsManager::Get().GetSetting<int>("editor/autoSaveDelay");
+        m_autoSaveTimer.StartOnce(delay.found && delay.value > 0 ? delay.value : 1000);
     }
-    
-    ClearIndicators();
-    
+
     if (statusBar)
         statusBar->UpdateCodeLocale(this);
 
     event.Skip();
 }
 
+bool Editor::IsAutoSaveEnabled() const
+{
+    return !m_largeFileMode && UserSettingsManager::Get().GetSetting<bool>("editor/autoSave").value &&
+           GetName() != UserSettingsManager::Get().SettingsPath;
+}
+
+void Editor::OnAutoSaveTimer(wxTimerEvent &WXUNUSED(event))
+{
+    AutoSave();
+}
+
+void Editor::OnKillFocus(wxFocusEvent &event)
+{
+    if (m_autoSaveTimer.IsRunning())
+        AutoSave();
+    event.Skip();
+}
+
+void Editor::AutoSave()
+{
+    m_autoSaveTimer.Stop();
+    if (!GetModify() || !IsAutoSaveEnabled() || (m_linked_container && m_linked_container->IsLoading()))
+        return;
+
+    const wxString path = GetName();
+    std::string content(GetCharacterPointer(), GetContentLength());
+    const uint64_t hash = FileOperations::ContentHash(content.data(), content.size());
+
+    // Edits that restored the saved content need no write
+    if (IsSavedContent(hash, content.size()))
+    {
+        MarkSaved();
+        return;
+    }
+
+    const uint64_t changeCount = m_changeCount;
+    const size_t length = content.size();
+    AutoSaveWriter::Get().Enqueue(path, std::move(content), [path, hash, length, changeCount](bool saved, size_t bytesWritten)
+                                  {
+        auto editor = dynamic_cast<Editor *>(wxFindWindowByLabel(path + "_codeEditor"));
+        auto statusBar = ((StatusBar *)wxFindWindowById(+GUI::ControlID::StatusBar));
+        if (statusBar)
+            statusBar->UpdateAutoSaveError(path, !saved);
+
+        if (!saved || !editor)
+            return;
+
+        wxLogStatus("Saved %zu bytes to '%s'", bytesWritten, path);
+        editor->SetSavedContent(hash, length);
+
+        // Edits made while the copy was written keep the document modified
+        if (editor->m_changeCount == changeCount)
+            editor->MarkSaved();
+
+        if (path == ShortCutSettingsManager::Get().ShortcutsPath)
+            ShortCutSettingsManager::Get().LoadSettingsFromFile(); });
+}
+
+void Editor::FlushAutoSave()
+{
+    m_autoSaveTimer.Stop();
+
+    // Also when the copy is queued or being written: its callback runs later, the document still looks modified
+    if (m_linked_container && GetModify() && IsAutoSaveEnabled() && !m_linked_container->IsLoading())
+        m_linked_container->Save(GetName());
+}
+
+static bool SetEditorStateEntry(json &entries, const std::string &key, json value, bool isDefault)
+{
+    auto entry = entries.find(key);
+    if (isDefault)
+    {
+        if (entry == entries.end())
+            return false;
+        entries.erase(entry);
+        return true;
+    }
+
+    if (entry != entries.end() && *entry == value)
+        return false;
+    entries[key] = std::move(value);
+    return true;
+}
+
+void Editor::SaveStates(const std::vector<Editor *> &editors)
+{
+    auto &storage = WorkspaceStorageManager::Get();
+    auto positions = storage.GetSetting<json>("cursor_positions");
+    auto folds = storage.GetSetting<json>("folded_regions");
+    if (!positions.value.is_object())
+        positions.value = json::object();
+    if (!folds.value.is_object())
+        folds.value = json::object();
+
+    bool changed = false;
+    for (auto editor : editors)
+    {
+        if (editor)
+            changed |= editor->StoreState(positions.value, folds.value);
+    }
+
+    if (changed)
+        storage.SetSettings({{"cursor_positions", std::move(positions.value)}, {"folded_regions", std::move(folds.value)}});
+}
+
+bool Editor::StoreState(json &positions, json &folds)
+{
+    if (GetName().IsEmpty() || (m_linked_container && m_linked_container->IsLoading()))
+        return false;
+
+    const std::string key = GetName().utf8_string();
+    const int anchor = GetAnchor();
+    const int caret = GetCurrentPos();
+    const int firstLine = DocLineFromVisible(GetFirstVisibleLine());
+
+    // Contracted headers are jumped to directly, a document is never walked line by line
+    json folded = json::array();
+    int previous = 0;
+    for (int line = ContractedFoldNext(0); line >= 0; line = ContractedFoldNext(line + 1))
+    {
+        folded.push_back(line - previous);
+        previous = line;
+    }
+
+    const bool positionChanged = SetEditorStateEntry(positions, key, json::array({anchor, caret, firstLine}),
+                                                     anchor == 0 && caret == 0 && firstLine == 0);
+    const bool foldsChanged = SetEditorStateEntry(folds, key, folded, folded.empty());
+    return positionChanged || foldsChanged;
+}
+
+void Editor::RestoreState()
+{
+    const std::string key = GetName().utf8_string();
+    auto &storage = WorkspaceStorageManager::Get();
+
+    auto folds = storage.GetSetting<json>("folded_regions");
+    if (!m_largeFileMode && folds.found && folds.value.is_object() && folds.value.contains(key))
+        RestoreFoldedHeaders(folds.value[key]);
+
+    auto positions = storage.GetSetting<json>("cursor_positions");
+    if (!positions.found || !positions.value.is_object() || !positions.value.contains(key))
+        return;
+
+    const json &position = positions.value[key];
+    if (!position.is_array() || position.size() != 3 || !position[0].is_number_integer() ||
+        !position[1].is_number_integer() || !position[2].is_number_integer())
+        return;
+
+    // The file may have changed on disk since the state was saved
+    const int length = GetLength();
+    SetAnchor(std::clamp(position[0].get<int>(), 0, length));
+    SetCurrentPos(std::clamp(position[1].get<int>(), 0, length));
+    ChooseCaretX();
+    SetFirstVisibleLine(VisibleFromDocLine(std::clamp(position[2].get<int>(), 0, GetLineCount() - 1)));
+}
+
+void Editor::RestoreFoldedHeaders(const json &folded)
+{
+    if (!folded.is_array() || folded.empty())
+        return;
+
+    std::vector<int> headers;
+    headers.reserve(folded.size());
+    int line = 0;
+    for (const auto &delta : folded)
+    {
+        if (!delta.is_number_integer() || delta.get<int>() < 0)
+            return;
+        line += delta.get<int>();
+        headers.push_back(line);
+    }
+
+    const int lineCount = GetLineCount();
+    if (headers.front() >= lineCount)
+        return;
+
+    // Fold levels are computed by the lexer, GetLastChild() styles the rest of each region itself
+    Colourise(0, GetLineEndPosition(std::min(headers.back(), lineCount - 1)));
+
+    int hiddenUntil = -1;
+    for (int header : headers)
+    {
+        if (header >= lineCount)
+            break;
+        if (!(GetFoldLevel(header) & wxSTC_FOLDLEVELHEADERFLAG))
+            continue;
+
+        const int lastChild = GetLastChild(header, -1);
+        if (lastChild <= header)
+            continue;
+
+        SetFoldExpanded(header, false);
+
+        // Headers nested in a contracted region only need their flag, their lines are already hidden
+        if (header > hiddenUntil)
+        {
+            HideLines(header + 1, lastChild);
+            hiddenUntil = lastChild;
+        }
+    }
+}
+
+void Editor::MarkSaved()
+{
+    SetSavePoint();
+    changedFile = false;
+    UpdateUnsavedIndicator();
+}
+
 void Editor::OnMarginClick(wxStyledTextEvent &event)
 {
     if (event.GetMargin() != EditorConstants::FOLD_MARGIN)
@@ -188,7 +591,8 @@ void Editor::OnBackspace(wxKeyEvent &event)
 
 void Editor::OnArrowsPress(wxKeyEvent &event)
 {
-    ClearIndicators();
+    if (!m_largeFileMode)
+        ClearIndicators();
 
     if (statusBar)
         statusBar->UpdateCodeLocale(this);
@@ -198,7 +602,8 @@ void Editor::OnArrowsPress(wxKeyEvent &event)
 
 void Editor::OnClick(wxMouseEvent &event)
 {
-    HighlightSelectionOccurrences();
+    if (!m_largeFileMode)
+        HighlightSelectionOccurrences();
 
     if (statusBar)
         statusBar->UpdateCodeLocale(this);
@@ -239,67 +644,148 @@ void Editor::HighlightSelectionOccurrences()
         !std::isalnum(static_cast<unsigned char>(text[0])))
         return;
 
-    SetIndicatorCurrent(EditorConstants::INDICATOR_DEFAULT);
+    m_occurrenceText = text;
+    m_occurrenceSelection = start;
+
+    // The visible lines are marked right away, whatever the size of the document
+    const int firstVisible = GetFirstVisibleLine();
+    const int firstLine = DocLineFromVisible(firstVisible);
+    const int lastLine = std::min(DocLineFromVisible(firstVisible + LinesOnScreen()) + 1, GetLineCount() - 1);
+    const int viewStart = PositionFromLine(firstLine);
+    const int viewEnd = GetLineEndPosition(lastLine);
 
-    int pos = 0;
+    HighlightOccurrencesIn(viewStart, viewEnd);
+
+    // The rest is searched at idle time, below the viewport first
+    if (viewEnd < GetTextLength())
+        m_occurrenceRanges.emplace_back(viewEnd, GetTextLength());
+    if (viewStart > 0)
+        m_occurrenceRanges.emplace_back(0, viewStart);
+}
+
+void Editor::HighlightOccurrencesIn(int from, int to)
+{
     const int max = GetTextLength();
+    const int length = (int)m_occurrenceText.utf8_str().length();
 
-    while (pos < max)
+    // A match starting inside the range may end after it
+    const int searchEnd = std::min(to + length - 1, max);
+    int pos = from;
+
+    while (pos < to)
     {
-        int found = FindText(pos, max, text,
-                             wxSTC_FIND_MATCHCASE | wxSTC_FIND_WHOLEWORD);
-        if (found == -1)
+        int foundEnd = 0;
+        int found = FindText(pos, searchEnd, m_occurrenceText,
+                             wxSTC_FIND_MATCHCASE | wxSTC_FIND_WHOLEWORD, &foundEnd);
+        if (found == -1 || found >= to)
             break;
 
-        if (found != start)
-            IndicatorFillRange(found, text.Length());
+        if (found != m_occurrenceSelection)
+            FillIndicator(EditorConstants::INDICATOR_DEFAULT, found, foundEnd - found);
 
-        pos = found + text.Length();
+        pos = foundEnd;
     }
 }
 
-void Editor::ClearIndicators()
+void Editor::OnIdle(wxIdleEvent &event)
 {
-    const int len = GetTextLength();
+    event.Skip();
+    if (m_occurrenceRanges.empty())
+        return;
 
-    for (int i = 0; i <= EditorConstants::MAX_INDICATOR; ++i)
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(EditorConstants::OCCURRENCES_IDLE_BUDGET_MS);
+
+    while (!m_occurrenceRanges.empty() && std::chrono::steady_clock::now() < deadline)
     {
-        IndicatorClearRange(0, len);
+        auto &range = m_occurrenceRanges.front();
+        const int chunkEnd = std::min(range.first + EditorConstants::OCCURRENCES_SCAN_CHUNK, range.second);
+
+        HighlightOccurrencesIn(range.first, chunkEnd);
+        range.first = chunkEnd;
+        if (range.first >= range.second)
+            m_occurrenceRanges.erase(m_occurrenceRanges.begin());
     }
+
+    if (!m_occurrenceRanges.empty())
+        event.RequestMore();
 }
 
-void Editor::OnCopy(wxCommandEvent &event)
+void Editor::ClearIndicators()
 {
-    CopyAllowLine();
+    // Pending occurrence searches refer to the previous selection and positions
+    m_occurrenceRanges.clear();
+    m_occurrenceSelection = -1;
+
+    for (int i = 0; i <= EditorConstants::MAX_INDICATOR; ++i)
+        ClearIndicator(i);
 }
 
-void Editor::UpdateUnsavedIndicator()
+void Editor::ClearIndicator(int indicator)
 {
-    wxWindow *tab = FindWindowByLabel(ProjectSettings::Get().GetCurrentlyFileOpen() + "_tab");
+    auto &span = m_indicatorSpans[indicator];
+    const int start = std::max(span.first, 0);
+    const int end = std::min(span.second, GetTextLength());
+    span = {0, 0};
 
-    if (!tab || !Modified())
+    if (start >= end)
         return;
 
-    wxStaticBitmap *icon = nullptr;
+    SetIndicatorCurrent(indicator);
+    IndicatorClearRange(start, end - start);
+}
+
+void Editor::FillIndicator(int indicator, int start, int length)
+{
+    if (length <= 0)
+        return;
+
+    SetIndicatorCurrent(indicator);
+    IndicatorFillRange(start, length);
+
+    auto &span = m_indicatorSpans[indicator];
+    if (span.first >= span.second)
+        span = {start, start + length};
+    else
+        span = {std::min(span.first, start), std::max(span.second, start + length)};
+}
 
-    for (auto children : tab->GetChildren()[0]->GetChildren())
+void Editor::ShiftIndicatorSpans(int position, int delta)
+{
+    for (auto &span : m_indicatorSpans)
     {
-        if (children->GetName() == "tab_icon_close_or_unsaved")
+        if (span.first >= span.second)
+            continue;
+
+        if (delta > 0)
         {
-            icon = wxDynamicCast(children, wxStaticBitmap);
-            break;
+            // Text inserted at the edge of a span may take its indicator, the span grows to cover it
+            if (position < span.first)
+                span.first += delta;
+            if (position <= span.second)
+                span.second += delta;
+        }
+        else
+        {
+            // Positions inside the deleted text collapse onto its start
+            const int removedEnd = position - delta;
+            if (span.first > position)
+                span.first -= std::min(span.first, removedEnd) - position;
+            if (span.second > position)
+                span.second -= std::min(span.second, removedEnd) - position;
         }
     }
+}
 
-    icon->SetBitmap(
-        wxBitmapBundle::FromBitmap(
-            wxBitmap(
-                iconsDir + "unsaved" +
-                    (ThemesManager::Get().IsDarkTheme() ? "_light" : "_dark") +
-                    ".png",
-                wxBITMAP_TYPE_PNG)));
+void Editor::OnCopy(wxCommandEvent &event)
+{
+    CopyAllowLine();
+}
 
-    tab->Layout();
+void Editor::UpdateUnsavedIndicator()
+{
+    if (m_tabIcon)
+        m_tabIcon->SetModified(Modified());
 }
 
 void Editor::HandleAutoPairing(char chr)
@@ -362,16 +848,11 @@ void Editor::CharAdd(wxStyledTextEvent &event)
 
         if (len > 0)
         {
-            const wxString word = GetTextRange(start, pos);
-            wxString list;
-            list.reserve(256);
-
-            for (const auto &kw : m_AutoCompleteWordsList)
-                if (kw.StartsWith(word))
-                    list << kw << ' ';
+            const std::string word = GetTextRange(start, pos).utf8_string();
+            BuildCompletionList(word);
 
-            if (!list.empty())
-                AutoCompShow(len, list);
+            if (!m_completionList.empty())
+                AutoCompShow(len, wxString::FromUTF8(m_completionList));
             else
                 AutoCompCancel();
         }
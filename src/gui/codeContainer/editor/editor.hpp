@@ -21,6 +21,9 @@
 #include "gui/widgets/statusBar/statusBar.hpp"
 #include "languagesPreferences/languagesPreferences.hpp"
 #include "userSettings/userSettings.hpp"
+#include "bufferWordIndex/bufferWordIndex.hpp"
+#include "gui/panels/tabs/tabIcon/tabIcon.hpp"
+#include "workspaceStorageManager/workspaceStorageManager.hpp"
 
 class CodeContainer;
 
@@ -28,6 +31,12 @@ class CodeContainer;
 using json = nlohmann::json;
 
 #include <wx/stc/stc.h>
+#include <wx/timer.h>
+#include <wx/weakref.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -53,10 +62,20 @@ namespace EditorConstants
     constexpr int FOLD_MARGIN_WIDTH = 20;
     /** @brief Default indicator index used primarily for selection occurrence highlighting. */
     constexpr int INDICATOR_DEFAULT = 0;
+    /** @brief Indicator marking the matches of the in-editor search panel. */
+    constexpr int SEARCH_INDICATOR = 8;
     /** @brief The maximum valid indicator index that can be used. */
-    constexpr int MAX_INDICATOR = 7;
+    constexpr int MAX_INDICATOR = SEARCH_INDICATOR;
+    /** @brief Maximum number of words shown in the autocomplete list. */
+    constexpr size_t AUTOCOMPLETE_MAX_ITEMS = 50;
+    /** @brief Lines above and below the caret whose words rank first in the autocomplete list. */
+    constexpr int AUTOCOMPLETE_NEARBY_LINES = 50;
     /** @brief Minimum text length required for selection occurrence highlighting to activate. */
     constexpr int MIN_SELECTION_LENGTH = 2;
+    /** @brief Time spent highlighting off-screen occurrences per idle event, in milliseconds. */
+    constexpr int OCCURRENCES_IDLE_BUDGET_MS = 8;
+    /** @brief Bytes searched between two checks of the idle time budget. */
+    constexpr int OCCURRENCES_SCAN_CHUNK = 64 * 1024;
 }
 
 /**
@@ -119,6 +138,11 @@ public:
      */
     Editor(wxWindow *parent);
 
+    /**
+     * @brief Removes the document words from the shared word index.
+     */
+    ~Editor();
+
     /**
      * @brief Checks if the document has unsaved modifications.
      * @return **true** if the document has unsaved changes (**GetModify()** is true) and is not read-only.
@@ -126,10 +150,21 @@ public:
     bool Modified() const;
 
     /**
-     * @brief Sets the list of words used for auto-completion suggestions.
-     * @param words A vector of strings containing all valid auto-completion words.
+     * @brief Sets the index of the words used for auto-completion suggestions.
+     * @param index Keyword index of the current language, shared with the other editors (may be nullptr).
+     */
+    void SetCompletionIndex(std::shared_ptr<const CompletionIndex> index) { m_completionIndex = std::move(index); }
+
+    /**
+     * @brief Adds the document words to the index shared by the open documents of the language.
+     *
+     * The whole document is tokenized once; afterwards only the text around each
+     * change is tokenized again (see UpdateWordIndex()). Detach before
+     * SetDocPointer(), which swaps the document without modification events.
+     *
+     * @param index The word index of the document language, nullptr to detach.
      */
-    void SetAutoCompleteWordsList(const std::vector<wxString> &words) { m_AutoCompleteWordsList = words; }
+    void AttachWordIndex(std::shared_ptr<BufferWordIndex> index);
 
     /**
      * @brief Sets the language-specific preferences structure for the current file type.
@@ -137,6 +172,93 @@ public:
      */
     void SetLanguagesPreferences(languagePreferencesStruct languagePreferences) { this->m_LanguagePreferences = languagePreferences; }
 
+    /**
+     * @brief Switches the editor in or out of large-file mode.
+     *
+     * In large-file mode the document is not lexed, the fold margin is removed
+     * and neither selection-occurrence highlighting nor per-keystroke autosave
+     * run, so editing a huge file stays responsive.
+     *
+     * @param largeFileMode Whether the document exceeds the large-file thresholds.
+     */
+    void SetLargeFileMode(bool largeFileMode);
+
+    /**
+     * @brief Tells whether the editor runs in large-file mode.
+     */
+    bool IsLargeFileMode() const { return m_largeFileMode; }
+
+    /**
+     * @brief Returns the length of the document in bytes, without the int limit of GetLength().
+     */
+    size_t GetContentLength() { return (size_t)SendMsg(2006); } // SCI_GETLENGTH
+
+    /**
+     * @brief Hashes the current bytes of the document.
+     */
+    uint64_t GetContentHash();
+
+    /**
+     * @brief Remembers the hash and length of the content last loaded from or written to the file.
+     * @param hash Hash returned by GetContentHash().
+     * @param length Length in bytes of the content.
+     */
+    void SetSavedContent(uint64_t hash, size_t length)
+    {
+        m_savedContentHash = hash;
+        m_savedContentLength = length;
+        m_hasSavedContentHash = true;
+    }
+
+    /**
+     * @brief Tells whether a content matches what the file holds on disk.
+     * @param hash Hash returned by GetContentHash().
+     * @param length Length in bytes of the content, compared too so a hash collision alone never drops edits.
+     */
+    bool IsSavedContent(uint64_t hash, size_t length) const
+    {
+        return m_hasSavedContentHash && m_savedContentHash == hash && m_savedContentLength == length;
+    }
+
+    /**
+     * @brief Marks the document as saved and shows the close icon on its tab.
+     */
+    void MarkSaved();
+
+    /**
+     * @brief Sets the icon of the tab showing whether the document is saved.
+     * @param icon Icon of the tab of this document, released with the tab.
+     */
+    void SetTabIcon(TabIcon *icon) { m_tabIcon = icon; }
+
+    /**
+     * @brief Saves right away, on the UI thread, when autosave is enabled and the document is modified.
+     *
+     * Called before closing the editor so the pending edits are not reported as unsaved.
+     * The synchronous save also drops an autosaved copy still queued and waits for one being written.
+     */
+    void FlushAutoSave();
+
+    /**
+     * @brief Stores the caret, selection, first visible line and folded headers of editors in the workspace storage.
+     *
+     * The states are kept per file path under `cursor_positions` and
+     * `folded_regions`, and written with a single storage update, only if one
+     * of them changed. Editors still loading their document are skipped.
+     *
+     * @param editors The editors to save, nullptr entries are ignored.
+     */
+    static void SaveStates(const std::vector<Editor *> &editors);
+
+    /**
+     * @brief Restores the state saved by SaveStates() for the current file, if any.
+     *
+     * Folded headers are contracted directly in the document (fold flag and
+     * hidden lines), without toggling them one by one. Must be called once the
+     * document is loaded.
+     */
+    void RestoreState();
+
     /**
      * @brief Moves the selected lines one position up.
      *
@@ -167,6 +289,20 @@ public:
      * **Ctrl + Delete**.
      */
     void RemoveCurrentLine();
+
+    /**
+     * @brief Fills a range with an indicator and records it for ClearIndicators().
+     * @param indicator The indicator, between 0 and **MAX_INDICATOR**.
+     * @param start First position of the range.
+     * @param length Length of the range.
+     */
+    void FillIndicator(int indicator, int start, int length);
+
+    /**
+     * @brief Clears the span recorded by FillIndicator() for one indicator.
+     * @param indicator The indicator, between 0 and **MAX_INDICATOR**.
+     */
+    void ClearIndicator(int indicator);
     
     /**
      * @brief Handles the copy-to-clipboard event.
@@ -215,12 +351,91 @@ private:
      */
     bool changedFile = false;
 
+    wxWeakRef<TabIcon> m_tabIcon; ///< Close/unsaved icon of the tab of this document
+
+    /**
+     * @brief Whether the expensive editing features are disabled for a huge document.
+     */
+    bool m_largeFileMode = false;
+
+    /**
+     * @brief Hash of the content last loaded from or written to the file, lets Save skip unchanged writes.
+     */
+    uint64_t m_savedContentHash = 0;
+
+    /**
+     * @brief Length in bytes of the content m_savedContentHash was computed on.
+     */
+    size_t m_savedContentLength = 0;
+
+    /**
+     * @brief Whether m_savedContentHash is known.
+     */
+    bool m_hasSavedContentHash = false;
+
+    /**
+     * @brief Counts text insertions and deletions, tells whether the document changed while an autosave was written.
+     */
+    uint64_t m_changeCount = 0;
+
+    /**
+     * @brief Selected text whose occurrences are being highlighted.
+     */
+    wxString m_occurrenceText;
+
     /**
-     * @brief List of words for context-aware auto-completion.
+     * @brief Start of the selection, the only occurrence left unmarked.
+     */
+    int m_occurrenceSelection = -1;
+
+    /**
+     * @brief Ranges of match start positions still to be searched at idle time.
+     */
+    std::vector<std::pair<int, int>> m_occurrenceRanges;
+
+    /**
+     * @brief Span [first, second) covering the filled ranges of each indicator, empty when first >= second.
      *
-     * Populated by **SetAutoCompleteWordsList** based on the current file's language.
+     * ClearIndicators() only clears these spans, so it costs nothing when no indicator is filled.
+     */
+    std::array<std::pair<int, int>, EditorConstants::MAX_INDICATOR + 1> m_indicatorSpans{};
+
+    /**
+     * @brief Fires once the document has been left untouched for `editor/autoSaveDelay` milliseconds.
+     */
+    wxTimer m_autoSaveTimer;
+
+    /**
+     * @brief Index of the words for context-aware auto-completion.
+     *
+     * Populated by **SetCompletionIndex** based on the current file's language.
+     */
+    std::shared_ptr<const CompletionIndex> m_completionIndex;
+
+    /**
+     * @brief Buffer the autocomplete list is built in, reused between keystrokes.
+     */
+    std::string m_completionList;
+
+    /**
+     * @brief Identifiers of the open documents of the same language, offered next to the keywords.
      */
-    std::vector<wxString> m_AutoCompleteWordsList;
+    std::shared_ptr<BufferWordIndex> m_wordIndex;
+
+    /**
+     * @brief Words around m_nearbyWordsLine with their distance to it, reused between keystrokes.
+     */
+    BufferWordIndex::NearbyWords m_nearbyWords;
+
+    /**
+     * @brief Caret line m_nearbyWords was collected around, -1 once an edit made it stale.
+     */
+    int m_nearbyWordsLine = -1;
+
+    /**
+     * @brief Whether the caret line was edited since its words were added to m_nearbyWords.
+     */
+    bool m_nearbyWordsLineChanged = false;
 
     /**
      * @brief Language-specific configuration for the current document.
@@ -307,6 +522,46 @@ private:
      */
     void OnChange(wxStyledTextEvent &event);
 
+    /**
+     * @brief Keeps the word index current from a modification notification.
+     *
+     * Before an insertion or a deletion, the words touching the changed range
+     * are uncounted; after it, the words of the same, updated, range are
+     * counted again.
+     * The words cached around the caret are marked stale as well.
+     *
+     * @param event The modification event.
+     */
+    void UpdateWordIndex(wxStyledTextEvent &event);
+
+    /**
+     * @brief Moves a position to the boundary of the word it touches.
+     * @param position The position to move.
+     * @param direction -1 to move to the word start, 1 to move to the word end.
+     */
+    int WordIndexBoundary(int position, int direction);
+
+    /**
+     * @brief Fills m_completionList with the buffer words and keywords starting with a prefix.
+     * @param word The prefix typed before the caret.
+     */
+    void BuildCompletionList(const std::string &word);
+
+    /**
+     * @brief Returns the words around the caret line, collected again only when it moved or was made stale.
+     *
+     * An edit on the caret line only adds its words at distance 0; any other
+     * edit resets the cache (see UpdateWordIndex()).
+     */
+    const BufferWordIndex::NearbyWords &GetNearbyWords();
+
+    /**
+     * @brief Adds the words of a line to m_nearbyWords, keeping the smallest distance of each.
+     * @param line The line to tokenize.
+     * @param distance Its distance in lines from the caret.
+     */
+    void AddNearbyWords(int line, int distance);
+
     /**
      * @brief Handler for clicks on any margin (primarily the fold margin).
      * @param event The styled text event (**wxEVT_STC_MARGINCLICK**).
@@ -363,23 +618,84 @@ private:
      * @brief Highlights all instances of the current selection throughout the document.
      *
      * Uses the **INDICATOR_DEFAULT** to visually mark matching text occurrences.
+     * Only the visible lines are searched right away, the rest of the document
+     * is searched in time-boxed chunks at idle time (see OnIdle()).
      */
     void HighlightSelectionOccurrences();
 
+    /**
+     * @brief Marks the occurrences of m_occurrenceText starting in a range.
+     * @param from First start position to consider.
+     * @param to End (exclusive) of the start positions to consider.
+     */
+    void HighlightOccurrencesIn(int from, int to);
+
+    /**
+     * @brief Continues the occurrence search outside the viewport.
+     * @param event The idle event, asked for more idle time until the search is done.
+     */
+    void OnIdle(wxIdleEvent &event);
+
     /**
      * @brief Clears all active visual indicators across the entire document.
      *
-     * Removes occurrence highlights, custom error markers, etc.
+     * Removes occurrence highlights, custom error markers, etc. Only the spans
+     * recorded by FillIndicator() are cleared.
      */
     void ClearIndicators();
 
     /**
-     * @brief Updates any UI element (e.g., tab icon) that shows the file's unsaved status.
+     * @brief Moves the recorded indicator spans after text was inserted or deleted.
+     * @param position Where the text was inserted or deleted.
+     * @param delta Length of the inserted text, negative for a deletion.
+     */
+    void ShiftIndicatorSpans(int position, int delta);
+
+    /**
+     * @brief Tells the tab icon whether the document has unsaved changes.
      *
-     * Looks up the corresponding tab widget and sets a visual indicator (e.g., a small dot).
+     * The icon only changes its bitmap on a clean/dirty transition, so this is
+     * cheap enough to be called on every modification.
      */
     void UpdateUnsavedIndicator();
 
+    /**
+     * @brief Writes the state of the editor into the workspace state objects.
+     * @param positions The `cursor_positions` object, keyed by file path.
+     * @param folds The `folded_regions` object, keyed by file path.
+     * @return **true** if an entry changed.
+     */
+    bool StoreState(json &positions, json &folds);
+
+    /**
+     * @brief Contracts the saved fold headers of the document.
+     * @param folded Header lines, each one relative to the previous (the first to line 0).
+     */
+    void RestoreFoldedHeaders(const json &folded);
+
+    /**
+     * @brief Tells whether the document is autosaved (setting enabled, not the settings file, not in large-file mode).
+     */
+    bool IsAutoSaveEnabled() const;
+
+    /**
+     * @brief Hands a copy of the document to the AutoSaveWriter.
+     *
+     * The copy is written on the writer thread; the save point is only set
+     * if the document did not change in the meantime.
+     */
+    void AutoSave();
+
+    /**
+     * @brief Handler for the end of the autosave quiet period.
+     */
+    void OnAutoSaveTimer(wxTimerEvent &WXUNUSED(event));
+
+    /**
+     * @brief Autosaves a pending change when the editor loses the focus.
+     */
+    void OnKillFocus(wxFocusEvent &event);
+
     /**
      * @brief Inserts the corresponding closing character when an opening character is typed.
      * @param chr The just-typed opening character (e.g., '(', '"', '{').
@@ -9,6 +9,9 @@ wxBEGIN_EVENT_TABLE(Editor, wxStyledTextCtrl)
     EVT_MOUSEWHEEL(Editor::OnScroll)
     EVT_KEY_DOWN(Editor::OnBackspace)
     EVT_STC_UPDATEUI(wxID_ANY, Editor::OnUpdateUI)
+    EVT_TIMER(wxID_ANY, Editor::OnAutoSaveTimer)
+    EVT_KILL_FOCUS(Editor::OnKillFocus)
+    EVT_IDLE(Editor::OnIdle)
     
     EVT_MENU(+Event::Edit::CopyByKeyboard, Editor::OnCopy)
     
@@ -12,6 +12,8 @@ namespace DirContextMenu
         menuDir->Append(+Event::File::CreateDir, _("&New Folder"));
         if(!targetIsProjectInformations)
         menuDir->Append(+Event::File::DeleteDir, _("&Delete Folder"));
+        menuDir->AppendSeparator();
+        menuDir->Append(+Event::File::ExpandSubfolders, _("&Expand Subfolders"));
         return menuDir;
     }
 }
@@ -0,0 +1,157 @@
+#include "fileSystemEventBatcher.hpp"
+
+#include "platformInfos/platformInfos.hpp"
+#include "fileOperations/fileOperations.hpp"
+
+#include <wx/fswatcher.h>
+#include <wx/filename.h>
+#include <unordered_map>
+
+FileSystemEventBatcher::FileSystemEventBatcher(Handler handler)
+    : m_handler(std::move(handler))
+{
+}
+
+void FileSystemEventBatcher::Queue(int type, const wxString &oldPath, const wxString &newPath)
+{
+    if (oldPath.IsEmpty() || newPath.IsEmpty())
+        return;
+
+    // Temporary files of atomic saves never reach the tree, only their rename over the real file does
+    if (FileOperations::IsTemporaryWriteFile(newPath))
+        return;
+    if (FileOperations::IsTemporaryWriteFile(oldPath))
+    {
+        if (type == wxFSW_EVENT_RENAME)
+            Queue(wxFSW_EVENT_CREATE, newPath, newPath);
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (m_pending.empty())
+        m_firstQueued = now;
+
+    m_pending.push_back(FileSystemChange{type, oldPath, newPath});
+
+    if (now - m_firstQueued < std::chrono::milliseconds(MAX_LATENCY_MS))
+        Start(DEBOUNCE_MS, wxTIMER_ONE_SHOT);
+    else if (!IsRunning())
+        Start(0, wxTIMER_ONE_SHOT);
+}
+
+void FileSystemEventBatcher::Notify()
+{
+    Flush();
+}
+
+void FileSystemEventBatcher::Flush()
+{
+    Stop();
+    if (m_pending.empty())
+        return;
+
+    std::vector<FileSystemChange> pending;
+    pending.swap(m_pending);
+
+    auto groups = GroupByParent(Coalesce(pending));
+    if (!groups.empty() && m_handler)
+        m_handler(groups);
+}
+
+void FileSystemEventBatcher::Clear()
+{
+    Stop();
+    m_pending.clear();
+}
+
+std::vector<FileSystemChange> FileSystemEventBatcher::Coalesce(const std::vector<FileSystemChange> &changes)
+{
+    std::vector<FileSystemChange> pending = changes;
+    std::vector<bool> dropped(pending.size(), false);
+    std::unordered_map<wxString, size_t> lastChange;
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        auto &change = pending[i];
+
+        // Created under a temporary name then renamed: by the time the batch is applied only the final name exists
+        if (change.type == wxFSW_EVENT_RENAME && change.oldPath != change.newPath)
+        {
+            auto created = lastChange.find(change.oldPath);
+            if (created != lastChange.end() && pending[created->second].type == wxFSW_EVENT_CREATE)
+            {
+                dropped[created->second] = true;
+                lastChange.erase(created);
+                change = FileSystemChange{wxFSW_EVENT_CREATE, change.newPath, change.newPath};
+            }
+        }
+
+        if (change.type == wxFSW_EVENT_CREATE || change.type == wxFSW_EVENT_DELETE)
+        {
+            auto previous = lastChange.find(change.oldPath);
+            if (previous == lastChange.end())
+            {
+                lastChange[change.oldPath] = i;
+                continue;
+            }
+
+            dropped[i] = true;
+            if (pending[previous->second].type != change.type)
+            {
+                dropped[previous->second] = true;
+                lastChange.erase(previous);
+            }
+        }
+        else if (change.type == wxFSW_EVENT_RENAME || change.type == wxFSW_EVENT_MODIFY)
+        {
+            if (change.oldPath == change.newPath)
+            {
+                dropped[i] = true;
+                continue;
+            }
+            lastChange.erase(change.oldPath);
+            lastChange.erase(change.newPath);
+        }
+        else
+            dropped[i] = true;
+    }
+
+    std::vector<FileSystemChange> coalesced;
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        if (!dropped[i])
+            coalesced.push_back(std::move(pending[i]));
+    }
+    return coalesced;
+}
+
+std::vector<FileSystemChangeGroup> FileSystemEventBatcher::GroupByParent(const std::vector<FileSystemChange> &changes)
+{
+    std::vector<FileSystemChangeGroup> groups;
+    std::unordered_map<wxString, size_t> groupByParent;
+
+    for (const auto &change : changes)
+    {
+        wxString parentPath = GetParentPath(change.newPath);
+
+        auto group = groupByParent.find(parentPath);
+        if (group == groupByParent.end())
+        {
+            group = groupByParent.emplace(parentPath, groups.size()).first;
+            groups.push_back(FileSystemChangeGroup{parentPath, {}});
+        }
+        groups[group->second].changes.push_back(change);
+    }
+    return groups;
+}
+
+wxString FileSystemEventBatcher::GetParentPath(const wxString &path)
+{
+    wxFileName fullPath(path);
+    if (fullPath.IsDir())
+    {
+        fullPath.RemoveLastDir();
+        return fullPath.GetPath() + PlatformInfos::OsPathSeparator();
+    }
+    return fullPath.GetPath(wxPATH_GET_VOLUME | wxPATH_GET_SEPARATOR);
+}
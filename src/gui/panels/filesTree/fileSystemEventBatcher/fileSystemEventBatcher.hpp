@@ -0,0 +1,119 @@
+#pragma once
+
+#include <wx/string.h>
+#include <wx/timer.h>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+/**
+ * @struct FileSystemChange
+ * @brief A single change reported by the file system watcher.
+ */
+struct FileSystemChange
+{
+    int type = 0;     ///< wxFSW_EVENT_* change type
+    wxString oldPath; ///< Path of the changed entry
+    wxString newPath; ///< New path of the entry (equal to oldPath unless renamed)
+};
+
+/**
+ * @struct FileSystemChangeGroup
+ * @brief Coalesced changes sharing the same parent directory.
+ */
+struct FileSystemChangeGroup
+{
+    wxString parentPath;                   ///< Parent directory path, ending with the path separator
+    std::vector<FileSystemChange> changes; ///< Changes in the order they were reported
+};
+
+/**
+ * @class FileSystemEventBatcher
+ * @brief Debounces file system watcher events and hands them over in batches.
+ *
+ * A branch switch or a build can report thousands of events in a few
+ * milliseconds. The batcher collects them until the watcher has been quiet for
+ * a short debounce window (or a maximum latency elapsed), drops the changes
+ * that cancel each other out and groups the remaining ones by parent
+ * directory, so the tree is updated in one step.
+ */
+class FileSystemEventBatcher : public wxTimer
+{
+public:
+    /**
+     * @brief Callback receiving the coalesced groups, in order of first appearance.
+     */
+    using Handler = std::function<void(const std::vector<FileSystemChangeGroup> &)>;
+
+    /**
+     * @brief Constructs the batcher.
+     * @param handler Callback invoked on the UI thread with every flushed batch.
+     */
+    explicit FileSystemEventBatcher(Handler handler);
+
+    /**
+     * @brief Adds a watcher event to the pending batch and (re)arms the debounce timer.
+     *
+     * Events of the temporary files of atomic saves are dropped, and a rename
+     * of one over its destination is queued as a creation of the destination.
+     *
+     * @param type The wxFSW_EVENT_* change type.
+     * @param oldPath Path of the changed entry.
+     * @param newPath New path of the entry.
+     */
+    void Queue(int type, const wxString &oldPath, const wxString &newPath);
+
+    /**
+     * @brief Hands the pending batch over to the handler immediately.
+     */
+    void Flush();
+
+    /**
+     * @brief Drops the pending batch without handling it (e.g. when the project is closed).
+     */
+    void Clear();
+
+    /**
+     * @brief Removes redundant changes from a batch.
+     *
+     * Duplicated creations/deletions of a path are merged, and a creation
+     * followed by a deletion of the same path (or the opposite, as done by
+     * editors saving through a temporary file) cancels out. A creation followed
+     * by a rename of the created path becomes a creation of the new path.
+     * Changes that do not affect the tree structure are dropped.
+     *
+     * @param changes The changes in the order they were reported.
+     * @return The remaining changes, in their original order.
+     */
+    static std::vector<FileSystemChange> Coalesce(const std::vector<FileSystemChange> &changes);
+
+    /**
+     * @brief Groups changes by the directory containing the changed entry.
+     * @param changes The changes in the order they were reported.
+     * @return One group per parent directory, in order of first appearance.
+     */
+    static std::vector<FileSystemChangeGroup> GroupByParent(const std::vector<FileSystemChange> &changes);
+
+    /**
+     * @brief Returns the directory containing a path.
+     * @param path The file or directory path.
+     * @return The parent directory path, ending with the path separator.
+     */
+    static wxString GetParentPath(const wxString &path);
+
+protected:
+    /**
+     * @brief Flushes the batch once the debounce window elapsed.
+     */
+    virtual void Notify() override;
+
+private:
+    Handler m_handler;                                  ///< Receives the flushed batches
+    std::vector<FileSystemChange> m_pending;            ///< Changes collected since the last flush
+    std::chrono::steady_clock::time_point m_firstQueued; ///< Time the oldest pending change was queued
+
+    static constexpr int DEBOUNCE_MS = 100;    ///< Quiet time required before a batch is flushed
+    static constexpr int MAX_LATENCY_MS = 500; ///< Longest time a change may stay pending during a storm
+
+    wxDECLARE_NO_COPY_CLASS(FileSystemEventBatcher);
+};
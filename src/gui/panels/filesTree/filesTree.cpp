@@ -3,6 +3,7 @@
 #include "fileOperations/fileOperations.hpp"
 #include "themesManager/themesManager.hpp"
 #include "appPaths/appPaths.hpp"
+#include "iconsCache/iconsCache.hpp"
 #include "appConstants/appConstants.hpp"
 #include "ui/ids.hpp"
 #include "projectSettings/projectSettings.hpp"
@@ -18,6 +19,9 @@
 #include "gui/codeContainer/code.hpp"
 #include "gui/widgets/confirmDialog/confirmDialog.hpp"
 #include "gui/widgets/openFolderButton/openFolderButton.hpp"
+#include "app/frames/mainFrame.hpp"
+#include "workspaceStorageManager/workspaceStorageManager.hpp"
+#include "ignoreEngine/ignoreEngine.hpp"
 
 #include <vector>
 #include <wx/fswatcher.h>
@@ -28,9 +32,13 @@
 #include <wx/graphics.h>
 #include <wx/timer.h>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 FilesTree::FilesTree(wxWindow *parent, wxWindowID ID)
-    : wxPanel(parent, ID)
+    : wxPanel(parent, ID),
+      m_fileSystemEventBatcher([this](const std::vector<FileSystemChangeGroup> &groups)
+                               { ApplyFileSystemChanges(groups); })
 {
     auto *mainSizer = new wxBoxSizer(wxVERTICAL);
     SetBackgroundColour(ThemesManager::Get().GetColor("main"));
@@ -39,22 +47,18 @@ FilesTree::FilesTree(wxWindow *parent, wxWindowID ID)
     m_projectInformations->SetName(ProjectSettings::Get().GetProjectPath());
     auto *projectInfoSizer = new wxBoxSizer(wxHORIZONTAL);
 
-    m_projectInformations->Bind(wxEVT_RIGHT_UP, &FilesTree::OnDirRightClick, this);
+    m_projectInformations->Bind(wxEVT_RIGHT_UP, &FilesTree::ProjectInformationsRightClick, this);
     m_projectInformations->Bind(wxEVT_ENTER_WINDOW, &FilesTree::OnProjectInformationsHoverEnter, this);
 
-    wxString arrowPath = ApplicationPaths::GetIconPath("dir_arrow.png");
-    if (!arrowPath.IsEmpty())
+    const wxBitmap &arrowBitmap = IconsCache::Get().GetIcon("dir_arrow.png");
+    if (arrowBitmap.IsOk())
     {
-        wxBitmap arrowBitmap(arrowPath, wxBITMAP_TYPE_PNG);
-        if (arrowBitmap.IsOk())
-        {
-            m_projectInformationsNameArrow = new wxStaticBitmap(
-                m_projectInformations,
-                +GUI::ControlID::ProjectToolsArrow,
-                arrowBitmap);
-            projectInfoSizer->Add(m_projectInformationsNameArrow, 0, wxEXPAND);
-            m_projectInformationsNameArrow->Bind(wxEVT_RIGHT_UP, &FilesTree::OnDirRightClick, this);
-        }
+        m_projectInformationsNameArrow = new wxStaticBitmap(
+            m_projectInformations,
+            +GUI::ControlID::ProjectToolsArrow,
+            arrowBitmap);
+        projectInfoSizer->Add(m_projectInformationsNameArrow, 0, wxEXPAND);
+        m_projectInformationsNameArrow->Bind(wxEVT_RIGHT_UP, &FilesTree::ProjectInformationsRightClick, this);
     }
 
     m_projectInformationsName = new wxStaticText(
@@ -62,7 +66,7 @@ FilesTree::FilesTree(wxWindow *parent, wxWindowID ID)
         +GUI::ControlID::ProjectToolsName,
         ProjectSettings::Get().GetProjectName());
 
-    m_projectInformationsName->Bind(wxEVT_RIGHT_UP, &FilesTree::OnDirRightClick, this);
+    m_projectInformationsName->Bind(wxEVT_RIGHT_UP, &FilesTree::ProjectInformationsRightClick, this);
 
     auto font = m_projectInformationsName->GetFont();
     font.SetWeight(wxFONTWEIGHT_MEDIUM);
@@ -80,10 +84,14 @@ FilesTree::FilesTree(wxWindow *parent, wxWindowID ID)
 
     mainSizer->Add(m_projectInformations, 0, wxEXPAND | wxTOP | wxBOTTOM, 5);
 
-    m_projectFilesContainer = new wxScrolled<wxPanel>(this, +GUI::ControlID::ProjectFilesContainer);
-    m_projectFilesContainer->SetScrollbars(20, 20, 50, 50);
-        
+    CreateFilterBar(mainSizer);
+
+    m_projectFilesContainer = new wxPanel(this, +GUI::ControlID::ProjectFilesContainer);
     auto *filesContainerSizer = new wxBoxSizer(wxVERTICAL);
+
+    m_filesTreeView = new FilesTreeView(m_projectFilesContainer, this);
+    filesContainerSizer->Add(m_filesTreeView, 1, wxEXPAND);
+
     m_projectFilesContainer->SetSizerAndFit(filesContainerSizer);
     mainSizer->Add(m_projectFilesContainer, 1, wxEXPAND);
 
@@ -92,9 +100,146 @@ FilesTree::FilesTree(wxWindow *parent, wxWindowID ID)
     
     if (!ProjectSettings::Get().IsProjectSet())
     {
+        m_filesTreeView->Hide();
         new OpenFolderButton();
         m_projectInformations->Hide();
+        m_filterBar->Hide();
+    }
+}
+
+FilesTree::~FilesTree()
+{
+    m_fileSystemEventBatcher.Clear();
+    CancelAllDirectoryListings();
+    ResetProjectIndex();
+}
+
+void FilesTree::CreateFilterBar(wxSizer *sizer)
+{
+    m_filterBar = new wxTextCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxBORDER_NONE);
+    m_filterBar->SetHint(_("Filter files"));
+    m_filterBar->SetBackgroundColour(ThemesManager::Get().GetColor("secondary"));
+
+    m_filterBar->Bind(wxEVT_TEXT, &FilesTree::OnFilterTextChanged, this);
+    m_filterBar->Bind(wxEVT_KEY_DOWN, &FilesTree::OnFilterKeyDown, this);
+    m_filterBar->Bind(wxEVT_SET_FOCUS, &FilesTree::OnFilterFocus, this);
+
+    sizer->Add(m_filterBar, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 5);
+}
+
+void FilesTree::OnFilterTextChanged(wxCommandEvent &WXUNUSED(event))
+{
+    if (!m_filesTreeView->IsFiltering())
+        MarkUnwatchedProjectIndexStale();
+    ApplyFilter();
+}
+
+void FilesTree::OnFilterKeyDown(wxKeyEvent &event)
+{
+    if (event.GetKeyCode() != WXK_ESCAPE || m_filterBar->IsEmpty())
+    {
+        event.Skip();
+        return;
     }
+
+    m_filterBar->ChangeValue(wxEmptyString);
+    ApplyFilter();
+}
+
+void FilesTree::OnFilterFocus(wxFocusEvent &event)
+{
+    MarkUnwatchedProjectIndexStale();
+    if (!m_projectIndex || m_projectIndexStale)
+        BuildProjectIndex();
+    event.Skip();
+}
+
+void FilesTree::MarkUnwatchedProjectIndexStale()
+{
+    // Collapsed folders are not watched, changes inside them never reach ApplyFileSystemChanges
+    if (!IsWatchingWholeTree() && !m_projectIndexTask)
+        m_projectIndexStale = true;
+}
+
+void FilesTree::ApplyFilter()
+{
+    wxString query = m_filterBar->GetValue();
+    if (query.Trim(true).Trim(false).IsEmpty())
+    {
+        m_filesTreeView->ClearFilterResults();
+        return;
+    }
+
+    if (!m_projectIndex || m_projectIndexStale)
+        BuildProjectIndex();
+    if (!m_projectIndex)
+        return;
+
+    std::vector<int> rows;
+    m_projectIndex->Filter(query, rows);
+    m_filesTreeView->SetFilterResults(m_projectIndex, std::move(rows));
+}
+
+void FilesTree::BuildProjectIndex()
+{
+    int rootNode = m_filesTreeView->GetRootNode();
+    if (m_projectIndexTask || rootNode < 0)
+        return;
+
+    auto task = std::make_shared<DirectoryListingTask>();
+    m_projectIndexTask = task;
+    m_projectIndexStale = false;
+
+    const wxString root = m_filesTreeView->GetNode(rootNode).path;
+    const FilesTreeSortOrder sortOrder = m_filesTreeView->GetSortOrder();
+    const bool showHiddenDirs = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenDirs").value;
+    const bool showHiddenFiles = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenFiles").value;
+
+    std::thread([this, task, root, sortOrder, showHiddenDirs, showHiddenFiles]()
+                {
+        auto index = ProjectPathIndex::Build(
+            root, sortOrder,
+            [&](const wxString &path, const wxString &name, bool isDir)
+            { return IsEntryVisible(path, name, isDir, showHiddenDirs, showHiddenFiles); },
+            [&]()
+            {
+                std::lock_guard<std::mutex> lock(task->mutex);
+                return task->cancelled;
+            });
+
+        std::lock_guard<std::mutex> lock(task->mutex);
+        if (task->cancelled || !index)
+            return;
+
+        CallAfter([this, task, index]()
+                  { OnProjectIndexBuilt(task, index); }); })
+        .detach();
+}
+
+void FilesTree::OnProjectIndexBuilt(std::shared_ptr<DirectoryListingTask> task, std::shared_ptr<ProjectPathIndex> index)
+{
+    if (task != m_projectIndexTask || task->cancelled)
+        return;
+
+    m_projectIndexTask.reset();
+    m_projectIndex = index;
+
+    if (m_filterBar->IsEmpty())
+        return;
+
+    ApplyFilter();
+}
+
+void FilesTree::ResetProjectIndex()
+{
+    if (m_projectIndexTask)
+    {
+        std::lock_guard<std::mutex> lock(m_projectIndexTask->mutex);
+        m_projectIndexTask->cancelled = true;
+    }
+    m_projectIndexTask.reset();
+    m_projectIndex.reset();
+    m_projectIndexStale = true;
 }
 
 void FilesTree::LinkClickEventToProjectInformationsComponents()
@@ -107,21 +252,19 @@ void FilesTree::LinkClickEventToProjectInformationsComponents()
 
 void FilesTree::ProjectInformationsLeftClick(wxMouseEvent &)
 {
-    auto arrowBitmap = m_projectInformationsNameArrow->GetBitmap();
-    wxVector<wxBitmap> bitmaps;
+    int arrowRotation = 0;
 
     if (m_projectFilesContainer->IsShown())
     {
         m_projectFilesContainer->Hide();
-        bitmaps.push_back(wxBitmap(arrowBitmap.ConvertToImage().Rotate90(true), -1));
+        arrowRotation = 90;
     }
     else
     {
         m_projectFilesContainer->Show();
-        bitmaps.push_back(wxBitmap(arrowBitmap.ConvertToImage().Rotate90(false), -1));
     }
 
-    m_projectInformationsNameArrow->SetBitmap(wxBitmapBundle::FromBitmaps(bitmaps));
+    m_projectInformationsNameArrow->SetBitmap(IconsCache::Get().GetIcon("dir_arrow.png", arrowRotation));
 }
 
 void FilesTree::LoadProject(wxWindow *parent, wxString path)
@@ -138,7 +281,12 @@ void FilesTree::LoadProject(wxWindow *parent, wxString path)
     if (path.Last() != PlatformInfos::OsPathSeparator())
         path.Append(PlatformInfos::OsPathSeparator());
 
-    m_projectFilesContainer->DestroyChildren();
+    wxWindowList placeholders = m_projectFilesContainer->GetChildren();
+    for (auto &&child : placeholders)
+    {
+        if (child != m_filesTreeView)
+            child->Destroy();
+    }
 
     m_projectInformationsName->SetName(ProjectSettings::Get().GetProjectName());
     m_projectInformationsName->SetLabel(ProjectSettings::Get().GetProjectName());
@@ -151,8 +299,20 @@ void FilesTree::LoadProject(wxWindow *parent, wxString path)
     ProjectSettings::Get().SetCurrentlyMenuFile(ProjectSettings::Get().GetProjectPath());
 
     m_projectInformations->Show();
-
-    CreateDirectoryComponents(parent, path);
+    m_filesTreeView->Show();
+
+    m_fileSystemEventBatcher.Clear();
+    CancelAllDirectoryListings();
+    ResetProjectIndex();
+    m_filterBar->ChangeValue(wxEmptyString);
+    m_filterBar->Show();
+    m_watchedDirectories.clear();
+    IgnoreEngine::Get().SetRoot(path);
+    auto sortOrder = UserSettingsManager::Get().GetSetting<std::string>("view/filesTreeSortOrder");
+    m_filesTreeView->SetSortOrder(sortOrder.found && sortOrder.value == "ordinal" ? FilesTreeSortOrder::Ordinal : FilesTreeSortOrder::Natural);
+    int rootNode = m_filesTreeView->SetRoot(path);
+    RestoreTreeState(rootNode);
+    m_filesTreeView->RebuildRows();
 
     m_projectFilesContainer->Layout();
     Layout();
@@ -160,236 +320,435 @@ void FilesTree::LoadProject(wxWindow *parent, wxString path)
     m_projectInfosTools->Hide();
 }
 
+void FilesTree::ReloadIgnoreRules()
+{
+    if (!IgnoreEngine::Get().Reload())
+        return;
+
+    const wxString projectPath = ProjectSettings::Get().GetProjectPath();
+    if (projectPath.IsEmpty() || m_filesTreeView->GetRootNode() < 0)
+        return;
+
+    SaveTreeState();
+    UnwatchDirectories(projectPath);
+    LoadProject(m_projectFilesContainer, projectPath);
+}
+
 void FilesTree::CloseProject()
 {
-    if (m_projectFilesContainer)
-        m_projectFilesContainer->DestroyChildren();
+    m_fileSystemEventBatcher.Clear();
+    CancelAllDirectoryListings();
+    m_watchedDirectories.clear();
+    m_pendingExpandedDirs.clear();
+    ResetProjectIndex();
+    IgnoreEngine::Get().SetRoot(wxEmptyString);
+
+    if (m_filterBar)
+    {
+        m_filterBar->ChangeValue(wxEmptyString);
+        m_filterBar->Hide();
+    }
+
+    if (m_filesTreeView)
+    {
+        m_filesTreeView->Clear();
+        m_filesTreeView->Hide();
+    }
     if (m_projectInformations)
         m_projectInformations->Hide();
 
     SetFileHighlight(wxEmptyString);
 }
 
-void FilesTree::CreateDirectoryComponents(wxWindow *parent, const wxString &path)
+bool FilesTree::IsWatchingWholeTree()
 {
-    if (!parent)
+    return UserSettingsManager::Get().GetSetting<bool>("fileWatcher/watchWholeTree").value;
+}
+
+void FilesTree::WatchDirectory(const wxString &path)
+{
+    if (IsWatchingWholeTree() || path == ProjectSettings::Get().GetProjectPath())
         return;
-    if (!wxDirExists(path))
-    {
-        wxMessageBox(ErrorMessages::CannotOpenDirForReadContent, "Error", wxOK | wxICON_ERROR);
+    if (!m_watchedDirectories.insert(path).second)
         return;
-    }
 
-    auto showHiddenDirs = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenDirs");
-    auto showHiddenFiles = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenFiles");
+    auto mainFrame = (MainFrame *)wxGetTopLevelParent(this);
+    if (mainFrame)
+        mainFrame->AddEntry(wxFSWPath_Dir, path);
+}
 
-    std::vector<std::filesystem::directory_entry> folders, files;
+void FilesTree::UnwatchDirectories(const wxString &path, bool removeWatches)
+{
+    auto mainFrame = (MainFrame *)wxGetTopLevelParent(this);
 
-    for (auto const &entry : std::filesystem::directory_iterator{path.ToStdString()})
+    for (auto watched = m_watchedDirectories.begin(); watched != m_watchedDirectories.end();)
     {
-        wxString fileName = wxFileNameFromPath(wxString(entry.path()));
-        if (fileName.IsEmpty())
+        if (!watched->StartsWith(path))
+        {
+            ++watched;
             continue;
+        }
 
-        auto firstChar = fileName[0];
+        if (removeWatches && mainFrame)
+            mainFrame->RemoveEntry(*watched);
+        watched = m_watchedDirectories.erase(watched);
+    }
+}
+
+bool FilesTree::IsEntryVisible(const wxString &path, const wxString &name, bool isDir, bool showHiddenDirs, bool showHiddenFiles)
+{
+    if (name.IsEmpty())
+        return false;
+    if (name[0] == '.' && !(isDir ? showHiddenDirs : showHiddenFiles))
+        return false;
+    return !IgnoreEngine::Get().IsIgnored(path, isDir);
+}
 
-        if (entry.is_directory())
+void FilesTree::SaveTreeState()
+{
+    int rootNode = m_filesTreeView->GetRootNode();
+    if (rootNode < 0)
+        return;
+
+    constexpr size_t maxSnapshotEntries = 5000;
+    const wxString rootPath = m_filesTreeView->GetNode(rootNode).path;
+
+    json expanded = json::array();
+    json snapshot = json::object();
+
+    std::vector<int> pending{rootNode};
+    while (!pending.empty())
+    {
+        int node = pending.back();
+        pending.pop_back();
+
+        const auto &dir = m_filesTreeView->GetNode(node);
+        std::string relativePath = dir.path.Mid(rootPath.length()).utf8_string();
+        if (node != rootNode)
+            expanded.push_back(relativePath);
+
+        if (dir.loaded && dir.children.size() <= maxSnapshotEntries)
         {
-            if (showHiddenDirs.value == false && firstChar == '.')
-                continue;
-            folders.push_back(entry);
+            json dirs = json::array();
+            json files = json::array();
+            for (int child : dir.children)
+            {
+                const auto &entry = m_filesTreeView->GetNode(child);
+                (entry.isDir ? dirs : files).push_back(entry.name.utf8_string());
+            }
+            snapshot[relativePath] = {{"d", dirs}, {"f", files}};
         }
-        else
+
+        for (int child : dir.children)
         {
-            if (showHiddenFiles.value == false && firstChar == '.')
-                continue;
-            files.push_back(entry);
+            const auto &entry = m_filesTreeView->GetNode(child);
+            if (entry.isDir && entry.expanded)
+                pending.push_back(child);
         }
     }
 
-    auto sortRule = [](const std::filesystem::directory_entry &a, const std::filesystem::directory_entry &b)
-    {
-        return a.path().filename().string() < b.path().filename().string();
-    };
-
-    std::sort(folders.begin(), folders.end(), sortRule);
-    std::sort(files.begin(), files.end(), sortRule);
-
-    for (auto &folder : folders)
-        CreateDirContainer(parent, wxString(folder.path()));
-    for (auto &file : files)
-        CreateFileContainer(parent, wxString(file.path()));
+    WorkspaceStorageManager::Get().SetSetting("files_tree", json{{"expanded", expanded},
+                                                                 {"snapshot", snapshot},
+                                                                 {"sortOrder", (int)m_filesTreeView->GetSortOrder()}});
 }
 
-wxWindow *FilesTree::CreateFileContainer(wxWindow *parent, const wxString &path)
+void FilesTree::RestoreTreeState(int rootNode)
 {
-    if (!wxFileExists(path))
-    {
-        wxMessageBox(ErrorMessages::FileNotFound, "Error", wxOK | wxICON_ERROR);
-        return nullptr;
-    }
-    if (auto exists = FindWindowByLabel(path + "_file_container"))
-        return exists;
-    if (!parent)
-        return nullptr;
+    m_pendingExpandedDirs.clear();
+    const wxString rootPath = m_filesTreeView->GetNode(rootNode).path;
 
-    auto *parentSizer = parent->GetSizer();
-    auto *fileContainer = new wxPanel(parent);
-    auto *fileSizer = new wxBoxSizer(wxHORIZONTAL);
+    const FilesTreeSortOrder sortOrder = m_filesTreeView->GetSortOrder();
+    bool presorted = false;
 
-    fileContainer->SetMinSize(wxSize(fileContainer->GetSize().GetWidth(), 20));
-    fileContainer->SetSize(fileContainer->GetSize().GetWidth(), 20);
-    fileContainer->SetToolTip(path);
-
-    fileContainer->Bind(wxEVT_LEFT_UP, &FilesTree::OnFileLeftClick, this);
-    fileContainer->Bind(wxEVT_RIGHT_UP, &FilesTree::OnFileRightClick, this);
+    json snapshot = json::object();
+    auto state = WorkspaceStorageManager::Get().GetSetting<json>("files_tree");
+    if (state.found && state.value.is_object())
+    {
+        if (state.value.contains("expanded") && state.value["expanded"].is_array())
+        {
+            for (const auto &relativePath : state.value["expanded"])
+            {
+                if (relativePath.is_string())
+                    m_pendingExpandedDirs.insert(rootPath + wxString::FromUTF8(relativePath.get<std::string>()));
+            }
+        }
+        if (state.value.contains("snapshot") && state.value["snapshot"].is_object())
+            snapshot = std::move(state.value["snapshot"]);
 
-    fileContainer->SetName(path);
-    fileContainer->SetLabel(path + "_file_container");
+        // Listings are saved in display order, appended as is when the tree is still sorted the same way
+        presorted = state.value.contains("sortOrder") && state.value["sortOrder"].is_number_integer() &&
+                    state.value["sortOrder"].get<int>() == (int)sortOrder;
+    }
 
-    wxString iconPath;
-    if (FileOperations::IsImageFile(path))
-        iconPath = ApplicationPaths::GetLanguageIcon("image");
-    else
-        iconPath = LanguagesPreferences::Get().GetLanguageIconPath(path);
+    const bool showHiddenDirs = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenDirs").value;
+    const bool showHiddenFiles = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenFiles").value;
 
-    if (!iconPath.IsEmpty())
+    std::vector<int> pending{rootNode};
+    while (!pending.empty())
     {
-        wxBitmap iconBitmap(iconPath, wxBITMAP_TYPE_PNG);
-        if (iconBitmap.IsOk())
+        int node = pending.back();
+        pending.pop_back();
+
+        const wxString path = m_filesTreeView->GetNode(node).path;
+        auto listing = snapshot.find(path.Mid(rootPath.length()).utf8_string());
+        if (listing == snapshot.end() || !listing->is_object())
         {
-            auto *icon = new wxStaticBitmap(fileContainer, wxID_ANY, iconBitmap);
-            fileSizer->Add(icon, 0, wxALIGN_CENTRE_VERTICAL | wxLEFT, 8);
+            CreateDirectoryComponents(node, path);
+            continue;
         }
-    }
 
-    auto *fileName = new wxStaticText(fileContainer, wxID_ANY, wxFileNameFromPath(path));
-    fileName->SetName(path);
-    fileName->Bind(wxEVT_LEFT_UP, &FilesTree::OnFileLeftClick, this);
-    fileName->Bind(wxEVT_RIGHT_UP, &FilesTree::OnFileRightClick, this);
+        for (const auto &[kind, isDir] : {std::pair<const char *, bool>{"d", true}, {"f", false}})
+        {
+            if (!listing->contains(kind) || !(*listing)[kind].is_array())
+                continue;
+
+            for (const auto &name : (*listing)[kind])
+            {
+                if (!name.is_string())
+                    continue;
 
-    fileSizer->Add(fileName, 0, wxALIGN_CENTRE_VERTICAL | wxLEFT, 5);
-    fileContainer->SetSizerAndFit(fileSizer);
+                wxString entryName = wxString::FromUTF8(name.get<std::string>());
+                if (!IsEntryVisible(path + entryName, entryName, isDir, showHiddenDirs, showHiddenFiles))
+                    continue;
 
-    parentSizer->Add(fileContainer, 0, wxEXPAND);
-    parentSizer->Layout();
+                int child;
+                if (presorted)
+                {
+                    child = m_filesTreeView->InsertNode(node, path + entryName, isDir);
+                }
+                else
+                {
+                    std::string sortKey = FilesTreeView::MakeSortKey(entryName, sortOrder);
+                    int position = m_filesTreeView->FindSortedPosition(node, sortKey, isDir);
+                    child = m_filesTreeView->InsertNode(node, path + entryName, isDir, position, std::move(sortKey));
+                }
 
-    fileContainer->CallForEachChild([this](wxWindow *win)
-                                    {
-        win->Bind(wxEVT_ENTER_WINDOW, &FilesTree::OnComponentMouseEnter, this);
-        win->Bind(wxEVT_LEAVE_WINDOW, &FilesTree::OnComponentMouseExit, this); });
+                if (isDir && m_pendingExpandedDirs.erase(m_filesTreeView->GetNode(child).path))
+                {
+                    m_filesTreeView->SetExpanded(child, true);
+                    WatchDirectory(m_filesTreeView->GetNode(child).path);
+                    pending.push_back(child);
+                }
+                else if (!isDir && m_filesTreeView->GetNode(child).path == m_currentSelectedFile)
+                    m_filesTreeView->SetSelectedNode(child);
+            }
+        }
 
-    return fileContainer;
+        m_filesTreeView->GetNode(node).loaded = true;
+        CreateDirectoryComponents(node, path, true);
+    }
 }
 
-wxWindow *FilesTree::CreateDirContainer(wxWindow *parent, wxString path, bool withPosition, int pos)
+void FilesTree::ExpandRestoredDirectory(int node)
 {
-    if (wxString(path.Last()) != PlatformInfos::OsPathSeparator())
-        path.Append(PlatformInfos::OsPathSeparator());
+    const wxString path = m_filesTreeView->GetNode(node).path;
+    m_filesTreeView->SetExpanded(node, true);
+    WatchDirectory(path);
+    CreateDirectoryComponents(node, path);
+}
 
-    if (!parent)
-        return nullptr;
+void FilesTree::CreateDirectoryComponents(int parentNode, const wxString &path, bool revalidate, int expandDepth)
+{
+    if (parentNode < 0)
+        return;
     if (!wxDirExists(path))
     {
-        wxMessageBox(ErrorMessages::CannotOpenDirForReadContent, "Error", wxOK | wxICON_ERROR);
-        return nullptr;
+        if (!revalidate)
+            wxMessageBox(ErrorMessages::CannotOpenDirForReadContent, "Error", wxOK | wxICON_ERROR);
+        return;
     }
-    if (FindWindowByLabel(path + "_dir_container"))
-        return nullptr;
 
-    auto *parentSizer = parent->GetSizer();
-    auto *dirContainer = new wxPanel(parent);
+    CancelDirectoryListing(path);
 
-    dirContainer->SetMinSize(wxSize(dirContainer->GetSize().GetWidth(), 20));
-    dirContainer->SetSize(dirContainer->GetSize().GetWidth(), 20);
+    auto task = std::make_shared<DirectoryListingTask>();
+    task->revalidate = revalidate;
+    task->expandDepth = expandDepth;
+    m_directoryListings[path] = task;
+    m_filesTreeView->GetNode(parentNode).loading = true;
 
-    auto *dirSizer = new wxBoxSizer(wxVERTICAL);
-    dirContainer->SetToolTip(path);
+    const bool showHiddenDirs = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenDirs").value;
+    const bool showHiddenFiles = UserSettingsManager::Get().GetSetting<bool>("view/showHiddenFiles").value;
+    const FilesTreeSortOrder sortOrder = m_filesTreeView->GetSortOrder();
+    const std::filesystem::path directory(path.ToStdWstring());
 
-    dirContainer->Bind(wxEVT_LEFT_UP, &FilesTree::OnDirLeftClick, this);
-    dirContainer->Bind(wxEVT_RIGHT_UP, &FilesTree::OnDirRightClick, this);
+    std::thread([this, task, path, directory, showHiddenDirs, showHiddenFiles, sortOrder]()
+                {
+        constexpr size_t batchSize = 512;
+        constexpr auto batchInterval = std::chrono::milliseconds(50);
 
-    dirContainer->SetName(path);
-    dirContainer->SetLabel(path + "_dir_container");
+        auto batch = std::make_shared<std::vector<DirectoryListingEntry>>();
+        auto lastFlush = std::chrono::steady_clock::now();
+        std::vector<size_t> order;
 
-    auto *propsPanel = new wxPanel(dirContainer);
-    auto *propsSizer = new wxBoxSizer(wxHORIZONTAL);
+        auto flush = [&](bool finished, bool failed)
+        {
+            // Sort indices on the precomputed keys, then move every entry once
+            order.resize(batch->size());
+            for (size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                      {
+                const auto &first = (*batch)[a];
+                const auto &second = (*batch)[b];
+                if (first.isDir != second.isDir)
+                    return first.isDir;
+                return first.sortKey < second.sortKey; });
+
+            auto sorted = std::make_shared<std::vector<DirectoryListingEntry>>();
+            sorted->reserve(batch->size());
+            for (size_t index : order)
+                sorted->push_back(std::move((*batch)[index]));
+
+            std::lock_guard<std::mutex> lock(task->mutex);
+            if (task->cancelled)
+                return false;
+
+            CallAfter([this, task, path, entries = sorted, finished, failed]()
+                      { OnDirectoryListingBatch(task, path, entries, finished, failed); });
+
+            batch = std::make_shared<std::vector<DirectoryListingEntry>>();
+            lastFlush = std::chrono::steady_clock::now();
+            return true;
+        };
 
-    propsPanel->SetToolTip(path);
-    propsPanel->SetName(path);
-    propsPanel->SetLabel("dir_props");
-    propsPanel->Bind(wxEVT_LEFT_UP, &FilesTree::OnDirLeftClick, this);
+        std::error_code error;
+        std::filesystem::directory_iterator iterator(directory, error);
+        if (error)
+        {
+            flush(true, true);
+            return;
+        }
 
-    wxString arrowPath = ApplicationPaths::GetIconPath("dir_arrow.png");
-    if (!arrowPath.IsEmpty())
-    {
-        wxBitmap arrowBitmap(arrowPath, wxBITMAP_TYPE_PNG);
-        if (arrowBitmap.IsOk())
+        for (auto end = std::filesystem::directory_iterator(); iterator != end; iterator.increment(error))
         {
-            auto *arrow = new wxStaticBitmap(propsPanel, wxID_ANY, arrowBitmap);
-            propsSizer->Add(arrow, 0, wxALIGN_CENTRE_VERTICAL);
+            if (error)
+                break;
+
+            const auto &entry = *iterator;
+            std::error_code typeError;
+            bool isDir = entry.is_directory(typeError);
+
+            wxString entryPath(entry.path().wstring());
+            wxString name = wxFileNameFromPath(entryPath);
+            if (!IsEntryVisible(entryPath, name, isDir, showHiddenDirs, showHiddenFiles))
+                continue;
+
+            batch->push_back({entryPath, name, FilesTreeView::MakeSortKey(name, sortOrder), isDir});
+
+            if (batch->size() >= batchSize || std::chrono::steady_clock::now() - lastFlush >= batchInterval)
+            {
+                if (!flush(false, false))
+                    return;
+            }
         }
-    }
 
-    auto *dirName = new wxStaticText(propsPanel, wxID_ANY, wxFileNameFromPath(path.Clone().RemoveLast()));
-    dirName->SetName("dir_name");
-    dirName->Bind(wxEVT_LEFT_UP, &FilesTree::OnDirLeftClick, this);
-    dirName->Bind(wxEVT_RIGHT_UP, &FilesTree::OnDirRightClick, this);
+        flush(true, false); })
+        .detach();
+}
 
-    propsSizer->Add(dirName, 0, wxEXPAND | wxLEFT, 4);
-    propsPanel->SetSizerAndFit(propsSizer);
+void FilesTree::OnDirectoryListingBatch(std::shared_ptr<DirectoryListingTask> task, const wxString &path,
+                                        std::shared_ptr<std::vector<DirectoryListingEntry>> entries, bool finished, bool failed)
+{
+    auto current = m_directoryListings.find(path);
+    if (current == m_directoryListings.end() || current->second != task || task->cancelled)
+        return;
 
-    dirSizer->Add(propsPanel, 0, wxEXPAND | wxLEFT, 8);
+    int parentNode = m_filesTreeView->FindNode(path);
+    if (parentNode < 0)
+    {
+        CancelDirectoryListing(path);
+        return;
+    }
 
-    auto *childrenPanel = new wxPanel(dirContainer);
-    auto *childrenSizer = new wxBoxSizer(wxVERTICAL);
+    std::vector<int> restoredDirs;
+    std::vector<int> deeperDirs;
+    for (const auto &entry : *entries)
+    {
+        wxString entryPath = entry.isDir ? entry.path + PlatformInfos::OsPathSeparator() : entry.path;
+        if (task->revalidate)
+            task->seen.insert(entryPath);
+        if (m_filesTreeView->FindNode(entryPath) >= 0)
+            continue;
 
-    childrenPanel->SetName(path);
-    childrenPanel->SetLabel(path + "_dir_childrens");
-    childrenPanel->Bind(wxEVT_PAINT, &FilesTree::OnDirChildrensPaint, this);
+        int position = m_filesTreeView->FindSortedPosition(parentNode, entry.sortKey, entry.isDir);
+        int node = m_filesTreeView->InsertNode(parentNode, entry.path, entry.isDir, position, entry.sortKey);
 
-    childrenPanel->SetSizerAndFit(childrenSizer);
-    dirSizer->Add(childrenPanel, 0, wxEXPAND | wxLEFT, 10);
+        if (!entry.isDir && entry.path == m_currentSelectedFile)
+            m_filesTreeView->SetSelectedNode(node);
+        if (entry.isDir && m_pendingExpandedDirs.erase(entryPath))
+            restoredDirs.push_back(node);
+        if (entry.isDir && m_filesTreeView->GetNode(node).depth < task->expandDepth)
+            deeperDirs.push_back(node);
+    }
 
-    dirContainer->SetSizerAndFit(dirSizer);
-    childrenPanel->Hide();
+    if (finished)
+    {
+        if (task->revalidate)
+        {
+            std::vector<int> staleNodes;
+            for (int child : m_filesTreeView->GetNode(parentNode).children)
+            {
+                const auto &entry = m_filesTreeView->GetNode(child);
+                if (task->seen.count(entry.path))
+                    continue;
+                if (entry.isDir ? !wxDirExists(entry.path) : !wxFileExists(entry.path))
+                    staleNodes.push_back(child);
+            }
 
-    if (withPosition)
-        parentSizer->Insert(pos, dirContainer, 0, wxEXPAND);
-    else
-        parentSizer->Add(dirContainer, 0, wxEXPAND);
+            for (int stale : staleNodes)
+            {
+                if (m_filesTreeView->GetNode(stale).isDir)
+                    UnwatchDirectories(m_filesTreeView->GetNode(stale).path, false);
+                m_filesTreeView->RemoveNode(stale);
+            }
+        }
 
-    parent->Layout();
+        auto &dir = m_filesTreeView->GetNode(parentNode);
+        dir.loading = false;
+        dir.loaded = true;
+        m_directoryListings.erase(current);
+    }
+
+    for (int node : restoredDirs)
+        ExpandRestoredDirectory(node);
+    for (int node : deeperDirs)
+        ApplyExpandDepth(node, task->expandDepth);
 
-    dirContainer->CallForEachChild([this](wxWindow *win)
-                                   {
-        win->Bind(wxEVT_ENTER_WINDOW, &FilesTree::OnComponentMouseEnter, this);
-        win->Bind(wxEVT_LEAVE_WINDOW, &FilesTree::OnComponentMouseExit, this); });
+    m_filesTreeView->RebuildRows();
 
-    return dirContainer;
+    if (failed && !task->revalidate)
+        wxMessageBox(ErrorMessages::CannotOpenDirForReadContent, "Error", wxOK | wxICON_ERROR);
 }
 
-void FilesTree::OnDirChildrensPaint(wxPaintEvent &event)
+void FilesTree::CancelDirectoryListing(const wxString &path)
 {
-    auto target = ((wxPanel *)event.GetEventObject());
-    if (!target)
+    auto current = m_directoryListings.find(path);
+    if (current == m_directoryListings.end())
         return;
 
-    auto color = ThemesManager::Get().GetColor("border");
-    wxPaintDC dc(target);
+    {
+        std::lock_guard<std::mutex> lock(current->second->mutex);
+        current->second->cancelled = true;
+    }
+    m_directoryListings.erase(current);
 
-    dc.SetPen(wxPen(wxColor(color), 1.25, wxPENSTYLE_DOT));
-    dc.SetBrush(color);
-    dc.DrawLine(wxPoint(0, 0), wxPoint(0, target->GetSize().y));
+    int node = m_filesTreeView->FindNode(path);
+    if (node >= 0)
+    {
+        m_filesTreeView->RemoveChildren(node);
+        m_filesTreeView->GetNode(node).loading = false;
+        m_filesTreeView->GetNode(node).loaded = false;
+    }
 }
 
-void FilesTree::OnFileLeftClick(wxMouseEvent &event)
+void FilesTree::CancelAllDirectoryListings()
 {
-    auto file = ((wxWindow *)event.GetEventObject());
-    if (!file)
-        return;
+    while (!m_directoryListings.empty())
+        CancelDirectoryListing(m_directoryListings.begin()->first);
+}
 
-    wxString path = file->GetName();
+void FilesTree::OnFileLeftClick(const wxString &path)
+{
     if (!wxFileExists(path))
     {
         wxMessageBox(ErrorMessages::FileNotFound, "Error", wxOK | wxICON_ERROR);
@@ -434,6 +793,9 @@ bool FilesTree::OpenFile(const wxString &componentIdentifier, int line)
         if (!codeEditor)
         {
             codeEditor = new CodeContainer(mainCode, componentIdentifier);
+            tabsContainer->AttachDocument(componentIdentifier, codeEditor->editor);
+            codeEditor->RunWhenLoaded([codeEditor]()
+                                      { codeEditor->editor->RestoreState(); });
             mainCode->GetSizer()->Add(codeEditor, 1, wxEXPAND);
             codeEditor->Show();
             mainCode->GetSizer()->Layout();
@@ -444,7 +806,8 @@ bool FilesTree::OpenFile(const wxString &componentIdentifier, int line)
 
         if (codeEditor && line)
         {
-            ((wxStyledTextCtrl *)codeEditor->GetChildren()[0])->GotoLine(line);
+            codeEditor->RunWhenLoaded([codeEditor, line]()
+                                      { codeEditor->editor->GotoLine(line); });
         }
         
         hideOtherPanelsOfMainCode(codeEditor);
@@ -485,19 +848,15 @@ bool FilesTree::OpenFile(const wxString &componentIdentifier, int line)
     return true;
 }
 
-void FilesTree::OnFileRightClick(wxMouseEvent &event)
+void FilesTree::OnFileRightClick(const wxString &path)
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (!target)
-        return;
-
-    if (!wxFileExists(target->GetName()))
+    if (!wxFileExists(path))
     {
         wxMessageBox(ErrorMessages::FileNotFound, "Error", wxOK | wxICON_ERROR);
         return;
     }
 
-    ProjectSettings::Get().SetCurrentlyMenuFile(target->GetName());
+    ProjectSettings::Get().SetCurrentlyMenuFile(path);
     auto menuFile = FileContextMenu::Get();
     if (!menuFile)
     {
@@ -508,54 +867,42 @@ void FilesTree::OnFileRightClick(wxMouseEvent &event)
     PopupMenu(menuFile);
 }
 
-void FilesTree::OnDirLeftClick(wxMouseEvent &event)
+void FilesTree::OnDirLeftClick(const wxString &path)
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (!target)
-        return;
-
-    if (target->GetLabel() == "dir_props")
-        target = target->GetParent();
-    else if (target->GetName() == "dir_name")
-        target = target->GetGrandParent();
-
-    if (!wxDirExists(target->GetName()))
+    if (!wxDirExists(path))
     {
         wxMessageBox(ErrorMessages::CannotOpenDir, "Error", wxOK | wxICON_ERROR);
         return;
     }
 
-    ToggleDirVisibility(target->GetName());
+    ToggleDirVisibility(path);
 }
 
-void FilesTree::OnDirRightClick(wxMouseEvent &event)
+void FilesTree::OnDirRightClick(const wxString &path)
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (!target)
+    if (!wxDirExists(path))
+    {
+        wxMessageBox(ErrorMessages::CannotOpenDir, "Error", wxOK | wxICON_ERROR);
         return;
+    }
 
-    if (target->GetLabel() == "dir_props")
-        target = target->GetParent();
-    else if (target->GetName() == "dir_name")
-        target = target->GetGrandParent();
-
-    bool targetIsprojectInformations =
-        target->GetId() == +GUI::ControlID::ProjectToggler ||
-        target->GetId() == +GUI::ControlID::ProjectToolsName ||
-        target->GetId() == +GUI::ControlID::ProjectToolsArrow;
+    ProjectSettings::Get().SetCurrentlyMenuDir(path);
 
-    if (!wxDirExists(target->GetName()) && !targetIsprojectInformations)
+    auto menuDir = DirContextMenu::Get(false);
+    if (!menuDir)
     {
-        wxMessageBox(ErrorMessages::CannotOpenDir, "Error", wxOK | wxICON_ERROR);
+        wxMessageBox(ErrorMessages::CreateMenuContextError, "Error", wxOK | wxICON_ERROR);
         return;
     }
 
-    if (targetIsprojectInformations)
-        ProjectSettings::Get().SetCurrentlyMenuDir(ProjectSettings::Get().GetProjectPath());
-    else
-        ProjectSettings::Get().SetCurrentlyMenuDir(target->GetName());
+    PopupMenu(menuDir);
+}
 
-    auto menuDir = DirContextMenu::Get(targetIsprojectInformations);
+void FilesTree::ProjectInformationsRightClick(wxMouseEvent &)
+{
+    ProjectSettings::Get().SetCurrentlyMenuDir(ProjectSettings::Get().GetProjectPath());
+
+    auto menuDir = DirContextMenu::Get(true);
     if (!menuDir)
     {
         wxMessageBox(ErrorMessages::CreateMenuContextError, "Error", wxOK | wxICON_ERROR);
@@ -567,112 +914,158 @@ void FilesTree::OnDirRightClick(wxMouseEvent &event)
 
 void FilesTree::ToggleDirVisibility(const wxString &componentIdentifier, bool defaultShow)
 {
-    auto dirContainer = FindWindowByLabel(componentIdentifier + "_dir_container");
-
-    if (!dirContainer)
+    int node = m_filesTreeView->FindNode(componentIdentifier);
+    if (node < 0)
         return;
 
     if (!wxDirExists(componentIdentifier))
     {
-        auto parent = dirContainer->GetParent();
-        if (parent)
-        {
-            dirContainer->Destroy();
-            AdjustContainerSize(parent);
-        }
+        UnwatchDirectories(componentIdentifier, false);
+        m_filesTreeView->RemoveNode(node);
+        m_filesTreeView->RebuildRows();
         wxMessageBox(ErrorMessages::CannotOpenDir, "Error", wxOK | wxICON_ERROR);
         return;
     }
 
-    auto dirArrowIcon = ((wxStaticBitmap *)dirContainer->GetChildren()[0]->GetChildren()[0]);
-    auto dirChildrens = dirContainer->GetChildren()[1];
-
     ProjectSettings::Get().SetCurrentlyMenuDir(componentIdentifier);
 
-    if (dirArrowIcon && dirChildrens)
+    auto &dir = m_filesTreeView->GetNode(node);
+    if (defaultShow && dir.expanded)
+        return;
+
+    if (!dir.expanded)
     {
-        auto arrowBitmap = dirArrowIcon->GetBitmap();
-        if (defaultShow)
-        {
-            dirChildrens->Show();
-            return;
-        }
-        else if (!dirChildrens->IsShown())
-        {
-            dirArrowIcon->SetBitmap(wxBitmap(arrowBitmap.ConvertToImage().Rotate90(true), -1));
-            dirChildrens->Show();
-            CreateDirectoryComponents(dirChildrens, componentIdentifier);
-        }
-        else if (dirChildrens->IsShown())
-        {
-            dirChildrens->Hide();
-            dirArrowIcon->SetBitmap(wxBitmap(arrowBitmap.ConvertToImage().Rotate90(false), -1));
-        }
-        AdjustContainerSize(dirChildrens);
+        m_filesTreeView->SetExpanded(node, true);
+        WatchDirectory(componentIdentifier);
+        if (!dir.loaded && !dir.loading)
+            CreateDirectoryComponents(node, componentIdentifier);
     }
     else
     {
-        wxMessageBox(ErrorMessages::ToggleDirectoryVisibilityError, "Error", wxOK | wxICON_ERROR);
+        m_filesTreeView->SetExpanded(node, false);
+        if (dir.loading)
+            CancelDirectoryListing(componentIdentifier);
+
+        if (!IsWatchingWholeTree())
+        {
+            UnwatchDirectories(componentIdentifier);
+            m_filesTreeView->RemoveChildren(node);
+            m_filesTreeView->GetNode(node).loaded = false;
+        }
     }
+
+    m_filesTreeView->RebuildRows();
 }
 
-void FilesTree::OnPaint(wxPaintEvent &event)
+void FilesTree::CollapseAll()
 {
-    auto target = ((wxPanel *)event.GetEventObject());
-    if (!target)
+    int rootNode = m_filesTreeView->GetRootNode();
+    if (rootNode < 0)
         return;
-    if (target->GetId() == +GUI::ControlID::FilesTree)
+
+    m_pendingExpandedDirs.clear();
+    ApplyExpandDepth(rootNode, 0);
+    m_filesTreeView->RebuildRows();
+}
+
+void FilesTree::ExpandToDepth(const wxString &path, int levels)
+{
+    int node = m_filesTreeView->FindNode(path);
+    if (node < 0 || levels < 0)
         return;
+
+    ApplyExpandDepth(node, m_filesTreeView->GetNode(node).depth + levels);
+    m_filesTreeView->RebuildRows();
 }
 
-void FilesTree::AdjustContainerSize(wxWindow *target, bool reduceSize)
+void FilesTree::ApplyExpandDepth(int node, int maxDepth)
 {
-    if (!target)
+    auto &dir = m_filesTreeView->GetNode(node);
+    if (!dir.isDir)
         return;
 
-    wxWindow *parent = target;
-    const int mainContainerId = +GUI::ControlID::ProjectFilesContainer;
+    if (dir.depth >= maxDepth)
+    {
+        if (dir.expanded)
+            CollapseDirectory(node);
+        return;
+    }
 
-    if (!parent->IsShownOnScreen() || parent->GetChildren().empty() || reduceSize)
+    const wxString path = dir.path;
+    if (!dir.expanded)
     {
-        while (parent->GetId() != mainContainerId)
-        {
-            if (!parent->IsShownOnScreen())
-            {
-                parent->SetSize(wxSize(0, 0));
-                parent->SetMinSize(wxSize(0, 0));
-            }
-            parent->Layout();
+        m_filesTreeView->SetExpanded(node, true);
+        WatchDirectory(path);
+    }
 
-            wxSize size(parent->GetSize().x, 20);
-            for (auto &&child : parent->GetChildren())
-            {
-                if (child->IsShownOnScreen())
-                    size.SetHeight(size.y + child->GetSize().y + 2);
-            }
-            parent->Layout();
+    if (!dir.loaded && !dir.loading)
+    {
+        CreateDirectoryComponents(node, path, false, maxDepth);
+        return;
+    }
 
-            parent = parent->GetParent();
-            parent->SetMinSize(size);
-            parent->Layout();
-            parent = parent->GetParent();
-        }
+    if (dir.loading)
+    {
+        auto listing = m_directoryListings.find(path);
+        if (listing != m_directoryListings.end())
+            listing->second->expandDepth = std::max(listing->second->expandDepth, maxDepth);
     }
-    else
+
+    // Collapsing a child only releases nodes of its own subtree, so the indices stay valid
+    for (size_t i = 0; i < m_filesTreeView->GetNode(node).children.size(); ++i)
+        ApplyExpandDepth(m_filesTreeView->GetNode(node).children[i], maxDepth);
+}
+
+void FilesTree::CollapseDirectory(int node)
+{
+    const wxString path = m_filesTreeView->GetNode(node).path;
+
+    std::vector<int> expandedDirs{node};
+    while (!expandedDirs.empty())
     {
-        while (parent->GetId() != mainContainerId)
+        int current = expandedDirs.back();
+        expandedDirs.pop_back();
+
+        m_filesTreeView->SetExpanded(current, false);
+        if (m_filesTreeView->GetNode(current).loading)
+            CancelDirectoryListing(m_filesTreeView->GetNode(current).path);
+
+        for (int child : m_filesTreeView->GetNode(current).children)
         {
-            parent->SetMinSize(wxSize(parent->GetBestSize()));
-            parent->GetSizer()->Layout();
-            parent = parent->GetParent();
+            const auto &entry = m_filesTreeView->GetNode(child);
+            if (entry.isDir && entry.expanded)
+                expandedDirs.push_back(child);
         }
     }
 
-    if (m_projectFilesContainer)
+    for (auto pending = m_pendingExpandedDirs.begin(); pending != m_pendingExpandedDirs.end();)
     {
-        m_projectFilesContainer->FitInside();
-        m_projectFilesContainer->Layout();
+        if (pending->StartsWith(path))
+            pending = m_pendingExpandedDirs.erase(pending);
+        else
+            ++pending;
     }
+
+    if (!IsWatchingWholeTree())
+    {
+        UnwatchDirectories(path);
+        m_filesTreeView->RemoveChildren(node);
+        m_filesTreeView->GetNode(node).loaded = false;
+    }
+}
+
+void FilesTree::OnExpandSubfoldersRequested(wxCommandEvent &WXUNUSED(event))
+{
+    ExpandToDepth(ProjectSettings::Get().GetCurrentlyMenuDir(), EXPAND_SUBFOLDERS_LEVELS);
+}
+
+void FilesTree::OnPaint(wxPaintEvent &event)
+{
+    auto target = ((wxPanel *)event.GetEventObject());
+    if (!target)
+        return;
+    if (target->GetId() == +GUI::ControlID::FilesTree)
+        return;
 }
 
 void FilesTree::OnCreateDirRequested(wxCommandEvent &)
@@ -723,13 +1116,9 @@ void FilesTree::OnDeleteDirRequested(wxCommandEvent &)
                 wxMessageBox(ErrorMessages::DeleteDirRequestedError, "Error", wxOK | wxICON_ERROR);
                 return;
             }
-            auto target = wxFindWindowByLabel(dir + "_dir_container");
-            if (!target)
-                return;
-            wxWindow *parent = target->GetParent();
-            target->Destroy();
+            m_filesTreeView->RemoveNode(m_filesTreeView->FindNode(dir));
+            m_filesTreeView->RebuildRows();
             ProjectSettings::Get().SetCurrentlyMenuDir(ProjectSettings::Get().GetProjectPath());
-            AdjustContainerSize(parent, true);
         };
 
         auto dontAsk = UserSettingsManager::Get().GetSetting<bool>("prompt/confirmDirDelete");
@@ -899,216 +1288,199 @@ void FilesTree::OnRenameFileRequested(wxCommandEvent &)
     }
 }
 
-void FilesTree::OnFileSystemEvent(int type, const wxString &oldPath, wxString newPath)
+void FilesTree::OnFileSystemEvent(int type, const wxString &oldPath, const wxString &newPath)
 {
-    if (oldPath.IsEmpty() || newPath.IsEmpty())
+    m_fileSystemEventBatcher.Queue(type, oldPath, newPath);
+}
+
+void FilesTree::ApplyFileSystemChanges(const std::vector<FileSystemChangeGroup> &groups)
+{
+    if (m_filesTreeView->GetRootNode() < 0)
         return;
 
-    wxFileName fullPath(newPath);
-    wxString parentPath;
+    // The index is rebuilt in the background once the batch settles, the current results stay shown meanwhile
+    m_projectIndexStale = true;
+    if (m_filesTreeView->IsFiltering())
+        BuildProjectIndex();
 
-    if (fullPath.IsDir())
-    {
-        fullPath.RemoveLastDir();
-        parentPath = fullPath.GetPath() + PlatformInfos::OsPathSeparator();
-    }
-    else
+    for (const auto &group : groups)
     {
-        parentPath = fullPath.GetPath(wxPATH_GET_VOLUME | wxPATH_GET_SEPARATOR);
-    }
+        int parentNode = m_filesTreeView->FindNode(group.parentPath);
+        if (group.parentPath == ProjectSettings::Get().GetProjectPath())
+            parentNode = m_filesTreeView->GetRootNode();
 
-    auto parentComponent = wxFindWindowByLabel(parentPath + "_dir_childrens");
-    if (parentPath == ProjectSettings::Get().GetProjectPath())
-        parentComponent = m_projectFilesContainer;
-    if (!parentComponent)
-        return;
+        bool parentListed = parentNode >= 0 && (m_filesTreeView->GetNode(parentNode).loaded || m_filesTreeView->GetNode(parentNode).loading);
 
-    auto linkedEditor = ((CodeContainer *)FindWindowByName(oldPath + "_codeContainer"));
-    auto linkedTab = wxFindWindowByLabel(oldPath + "_tab");
-    bool isFile = !std::filesystem::is_directory(newPath.ToStdString());
-
-    auto CreateWithPosition = [this, newPath, isFile, parentComponent, parentPath]()
-    {
-        int position = 0;
-        const std::filesystem::path pd{wxFileName(parentPath).GetPath().ToStdString()};
-        for (auto const &entry : std::filesystem::directory_iterator{pd})
+        for (const auto &change : group.changes)
         {
-            if (entry.is_directory())
+            if (IgnoreEngine::IsIgnoreFile(wxFileNameFromPath(change.oldPath)) || IgnoreEngine::IsIgnoreFile(wxFileNameFromPath(change.newPath)))
+                IgnoreEngine::Get().InvalidateDirectory(group.parentPath);
+
+            if (parentListed)
             {
-                std::string dir_path = std::string(entry.path()) + PlatformInfos::OsPathSeparator().ToStdString();
-                if (dir_path == newPath.ToStdString())
-                    CreateDirContainer(parentComponent, newPath, true, position);
+                ApplyFileSystemChange(parentNode, change);
+                continue;
             }
-            else
+
+            // Moved into a folder that was never listed: the entry just leaves its old parent
+            if (change.type == wxFSW_EVENT_RENAME && change.oldPath != change.newPath)
             {
-                std::string file_path = std::string(entry.path());
-                if (file_path == newPath.ToStdString())
-                    CreateFileContainer(parentComponent, newPath);
+                int moved = m_filesTreeView->FindNode(change.oldPath);
+                if (moved < 0)
+                    moved = m_filesTreeView->FindNode(change.oldPath + PlatformInfos::OsPathSeparator());
+                if (moved >= 0 && m_filesTreeView->GetNode(moved).isDir)
+                    UnwatchDirectories(m_filesTreeView->GetNode(moved).path);
+                m_filesTreeView->RemoveNode(moved);
             }
-            position++;
-        }
-        
-        if(newPath == m_currentSelectedFile || newPath == ProjectSettings::Get().GetCurrentlyMenuFile()) {
-            SetFileHighlight(newPath);
         }
+    }
+
+    m_filesTreeView->RebuildRows();
+}
+
+void FilesTree::ApplyFileSystemChange(int parentNode, const FileSystemChange &change)
+{
+    const wxString &oldPath = change.oldPath;
+    const wxString &newPath = change.newPath;
+
+    auto FindComponent = [this](const wxString &path)
+    {
+        int node = m_filesTreeView->FindNode(path);
+        if (node < 0)
+            node = m_filesTreeView->FindNode(path + PlatformInfos::OsPathSeparator());
+        return node;
     };
 
-    if (type == wxFSW_EVENT_CREATE)
-        CreateWithPosition();
+    auto IsVisible = [](const wxString &path, bool isDir)
+    {
+        return IsEntryVisible(path, wxFileNameFromPath(path), isDir,
+                              UserSettingsManager::Get().GetSetting<bool>("view/showHiddenDirs").value,
+                              UserSettingsManager::Get().GetSetting<bool>("view/showHiddenFiles").value);
+    };
 
-    if (type == wxFSW_EVENT_DELETE)
+    if (change.type == wxFSW_EVENT_CREATE)
     {
-        auto component = wxFindWindowByLabel(oldPath + "_file_container");
-        if (!component)
+        if (FindComponent(newPath) >= 0)
+            return;
+
+        // A single stat tells both whether the entry still exists and what it is
+        std::error_code error;
+        const auto status = std::filesystem::status(std::filesystem::path(newPath.ToStdWstring()), error);
+        if (error || !std::filesystem::exists(status))
+            return;
+
+        const bool isFile = !std::filesystem::is_directory(status);
+        if (!IsVisible(newPath, !isFile))
+            return;
+
+        int position = m_filesTreeView->FindInsertPosition(parentNode, wxFileNameFromPath(newPath), !isFile);
+        m_filesTreeView->InsertNode(parentNode, newPath, !isFile, position);
+
+        if (newPath == m_currentSelectedFile || newPath == ProjectSettings::Get().GetCurrentlyMenuFile())
         {
-            if (auto dirComp = wxFindWindowByLabel(oldPath + PlatformInfos::OsPathSeparator() + "_dir_container"))
-                component = dirComp;
-            else
-                return;
+            SetFileHighlight(newPath);
         }
-        if (linkedTab)
+        return;
+    }
+
+    if (change.type == wxFSW_EVENT_DELETE)
+    {
+        int component = FindComponent(oldPath);
+        if (component < 0)
+            return;
+
+        if (!m_filesTreeView->GetNode(component).isDir)
         {
-            auto tabs = ((Tabs *)FindWindowById(+GUI::ControlID::Tabs));
-            if (tabs)
-                tabs->Close(linkedTab, linkedTab->GetName());
+            auto tabs = GetTabs();
+            if (auto linkedTab = tabs ? tabs->FindTab(oldPath) : nullptr)
+                tabs->Close(linkedTab, oldPath);
         }
-        if (component)
-            component->Destroy();
-        AdjustContainerSize(parentComponent, true);
+        if (m_filesTreeView->GetNode(component).isDir)
+            UnwatchDirectories(m_filesTreeView->GetNode(component).path, false);
+        m_filesTreeView->RemoveNode(component);
         return;
     }
 
-    if (type == wxFSW_EVENT_RENAME || type == wxFSW_EVENT_MODIFY)
+    if (change.type == wxFSW_EVENT_RENAME || change.type == wxFSW_EVENT_MODIFY)
     {
-        wxWindow *targetComp;
-        if (isFile)
-            targetComp = wxFindWindowByLabel(oldPath + "_file_container");
-        else
-            targetComp = wxFindWindowByLabel(oldPath + PlatformInfos::OsPathSeparator() + "_dir_container");
-        if (!targetComp)
+        int targetComp = FindComponent(oldPath);
+        if (targetComp < 0)
+        {
+            // The old name was never listed (a temporary file the tree skips, or one gone before its creation was applied)
+            if (change.type == wxFSW_EVENT_RENAME && oldPath != newPath)
+                ApplyFileSystemChange(parentNode, FileSystemChange{wxFSW_EVENT_CREATE, newPath, newPath});
             return;
+        }
 
-        if (targetComp->GetName() != newPath && oldPath != newPath)
+        if (oldPath != newPath)
         {
-            if (isFile)
+            const bool isFile = !m_filesTreeView->GetNode(targetComp).isDir;
+            if (!IsVisible(newPath, !isFile))
             {
-                targetComp->SetName(newPath);
-                targetComp->SetLabel(newPath + "_file_container");
-                auto fileName = ((wxStaticText *)targetComp->GetChildren()[1]);
-                if (fileName)
-                {
-                    fileName->SetName(newPath);
-                    fileName->SetLabel(wxFileNameFromPath(newPath));
-                }
-                auto fileIcon = ((wxStaticBitmap *)targetComp->GetChildren()[0]);
-                if (fileIcon)
+                if (!isFile)
+                    UnwatchDirectories(m_filesTreeView->GetNode(targetComp).path);
+                m_filesTreeView->RemoveNode(targetComp);
+                return;
+            }
+
+            // Like rename(2), the renamed entry replaces the one already at the new path
+            int replaced = FindComponent(newPath);
+            if (replaced >= 0 && replaced != targetComp)
+            {
+                if (m_filesTreeView->GetNode(replaced).isDir)
+                    UnwatchDirectories(m_filesTreeView->GetNode(replaced).path, false);
+                m_filesTreeView->RemoveNode(replaced);
+            }
+
+            wxString oldNodePath = m_filesTreeView->GetNode(targetComp).path;
+            m_filesTreeView->RenameNode(targetComp, newPath, parentNode);
+
+            if (!isFile)
+            {
+                std::vector<wxString> renamedWatches;
+                for (const auto &watched : m_watchedDirectories)
                 {
-                    wxString iconPath = LanguagesPreferences::Get().GetLanguageIconPath(newPath);
-                    if (!iconPath.IsEmpty())
-                    {
-                        wxBitmap iconBitmap(iconPath, wxBITMAP_TYPE_PNG);
-                        if (iconBitmap.IsOk())
-                            fileIcon->SetBitmap(iconBitmap);
-                    }
+                    if (watched.StartsWith(oldNodePath))
+                        renamedWatches.push_back(m_filesTreeView->GetNode(targetComp).path + watched.Mid(oldNodePath.length()));
                 }
-                if (linkedEditor)
-                    linkedEditor->LoadPath(newPath);
-                if (linkedTab)
+                UnwatchDirectories(oldNodePath);
+                for (const auto &watched : renamedWatches)
+                    WatchDirectory(watched);
+            }
+
+            if (isFile)
+            {
+                // Only open files have a tab, the editor is looked up for those alone
+                auto tabs = GetTabs();
+                if (tabs && tabs->FindTab(oldPath))
                 {
-                    linkedTab->SetName(newPath);
-                    linkedTab->SetLabel(newPath + "_tab");
-                    linkedTab->SetToolTip(newPath);
-                    auto tabText = ((wxStaticText *)linkedTab->GetChildren()[0]->GetChildren()[1]);
-                    if (tabText)
-                    {
-                        tabText->SetName(newPath);
-                        tabText->SetLabel(wxFileNameFromPath(newPath));
-                    }
-                    auto tabIcon = ((wxStaticBitmap *)linkedTab->GetChildren()[0]->GetChildren()[0]);
-                    if (tabIcon)
-                    {
-                        wxString tabIconPath = LanguagesPreferences::Get().GetLanguageIconPath(newPath);
-                        if (!tabIconPath.IsEmpty())
-                        {
-                            wxBitmap tabIconBitmap(tabIconPath, wxBITMAP_TYPE_PNG);
-                            if (tabIconBitmap.IsOk())
-                                tabIcon->SetBitmap(tabIconBitmap);
-                        }
-                    }
+                    if (auto linkedEditor = ((CodeContainer *)FindWindowByLabel(oldPath + "_codeContainer")))
+                        linkedEditor->LoadPath(newPath);
+                    tabs->Rename(oldPath, newPath);
                 }
+                if (oldPath == m_currentSelectedFile)
+                    m_currentSelectedFile = newPath;
             }
-            else
-                CreateWithPosition();
         }
     }
-    AdjustContainerSize(parentComponent);
-}
-
-void FilesTree::ChangeFileBackground(const wxString &componentIdentifier, wxColour color)
-{
-    auto target = FindWindowByLabel(componentIdentifier + "_file_container");
-    if (!target)
-    {
-        target = FindWindowByLabel(componentIdentifier + "_dir_container");
-        if (target)
-            target = target->GetChildren()[0];
-    }
-    if (!target)
-        return;
-    if (m_currentSelectedFile && m_currentSelectedFile->GetName() == target->GetName())
-        return;
-    target->SetBackgroundColour(color);
-    target->Refresh();
 }
 
-void FilesTree::OnComponentMouseEnter(wxMouseEvent &event)
+Tabs *FilesTree::GetTabs()
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (!target)
-        return;
-    auto color = ThemesManager::Get().GetColor("selectedFile");
-    wxString path = target->GetName();
-    if (path == "dir_name")
-        target = target->GetGrandParent();
-    ChangeFileBackground(target->GetName(), color);
-}
-
-void FilesTree::OnComponentMouseExit(wxMouseEvent &event)
-{
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (!target)
-        return;
-    auto color = ThemesManager::Get().GetColor("main");
-    wxString path = target->GetName();
-    if (path == "dir_name")
-        target = target->GetGrandParent();
-    ChangeFileBackground(target->GetName(), color);
+    if (!m_tabs)
+        m_tabs = ((Tabs *)FindWindowById(+GUI::ControlID::Tabs));
+    return m_tabs;
 }
 
 void FilesTree::SetFileHighlight(const wxString &componentIdentifier)
-{    
-    auto target = wxFindWindowByLabel(componentIdentifier + "_file_container");
-    auto defaultColor = ThemesManager::Get().GetColor("main");
-    auto selectedColor = ThemesManager::Get().GetColor("selectedFile");
-
-    if (m_currentSelectedFile)
-    {
-        wxWindow *oldWin = m_currentSelectedFile.get();
-        if (oldWin)
-        {
-            oldWin->SetBackgroundColour(defaultColor);
-            oldWin->Refresh();
-        }
-        m_currentSelectedFile = nullptr;
-    }
-
-    if (!target || componentIdentifier.IsEmpty())
-        return;
+{
+    m_currentSelectedFile = componentIdentifier;
 
-    target->SetBackgroundColour(selectedColor);
-    target->Refresh();
+    int node = componentIdentifier.IsEmpty() ? -1 : m_filesTreeView->FindNode(componentIdentifier);
+    if (node >= 0 && m_filesTreeView->GetNode(node).isDir)
+        node = -1;
 
-    m_currentSelectedFile = target;
+    m_filesTreeView->SetSelectedNode(node);
 }
 
 void FilesTree::OnProjectInformationsHoverEnter(wxMouseEvent &event)
@@ -1,7 +1,46 @@
 #pragma once
 
 #include <wx/wx.h>
+#include <filesystem>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include "projectInfosTools/projectInfosTools.hpp"
+#include "filesTreeView/filesTreeView.hpp"
+#include "fileSystemEventBatcher/fileSystemEventBatcher.hpp"
+#include "projectPathIndex/projectPathIndex.hpp"
+
+class Tabs;
+
+/**
+ * @struct DirectoryListingTask
+ * @brief State shared between a background directory listing and the UI thread.
+ *
+ * The worker only posts results while holding the mutex and while the task is
+ * not cancelled, so once CancelDirectoryListing() returns no new batch can be queued.
+ */
+struct DirectoryListingTask
+{
+    std::mutex mutex;       ///< Guards the cancellation flag against the posting worker
+    bool cancelled = false; ///< Set when the folder is collapsed or the project is closed
+    bool revalidate = false; ///< Whether the listing checks children restored from a snapshot
+    int expandDepth = -1;    ///< Reported directories shallower than this depth are expanded (expand-to-depth)
+    std::unordered_set<wxString> seen; ///< Paths reported by a revalidating listing (UI thread only)
+};
+
+/**
+ * @struct DirectoryListingEntry
+ * @brief A single entry produced by a background directory listing.
+ */
+struct DirectoryListingEntry
+{
+    wxString path;      ///< Absolute path of the entry
+    wxString name;       ///< File or directory name
+    std::string sortKey; ///< Sort key computed by the worker, see FilesTreeView::MakeSortKey()
+    bool isDir = false;  ///< Whether the entry is a directory
+};
 
 /**
  * @class FilesTree
@@ -20,6 +59,11 @@ public:
      */
     FilesTree(wxWindow *parent, wxWindowID ID);
 
+    /**
+     * @brief Cancels the pending directory listings before the tree is destroyed.
+     */
+    ~FilesTree();
+
     /**
      * @brief Loads a project into the file explorer.
      * @param parent The parent window.
@@ -36,6 +80,22 @@ public:
      */
     void CloseProject();
 
+    /**
+     * @brief Stores the expanded directories and a snapshot of their listings in the workspace storage.
+     *
+     * The state is restored by LoadProject() the next time the workspace is opened.
+     */
+    void SaveTreeState();
+
+    /**
+     * @brief Reloads the ignore settings and lists the project again if they changed.
+     *
+     * Called after settings.json was saved, so `files/exclude`, `search/exclude`
+     * and `files/useIgnoreFiles` apply without a restart. The expanded
+     * directories are kept.
+     */
+    void ReloadIgnoreRules();
+
     /**
      * @brief Handles a user request to create a new directory.
      * @param event The associated command event.
@@ -54,6 +114,12 @@ public:
      */
     void OnDeleteDirRequested(wxCommandEvent &WXUNUSED(event));
 
+    /**
+     * @brief Handles a user request to expand the subfolders of a directory.
+     * @param event The associated command event.
+     */
+    void OnExpandSubfoldersRequested(wxCommandEvent &WXUNUSED(event));
+
     /**
      * @brief Handles a user request to delete a file.
      * @param event The associated command event.
@@ -61,12 +127,16 @@ public:
     void OnDeleteFileRequested(wxCommandEvent &WXUNUSED(event));
 
     /**
-     * @brief Handles file system change events.
+     * @brief Queues a file system change event.
+     *
+     * Events are debounced and coalesced by the FileSystemEventBatcher, then
+     * applied to the tree in a single pass.
+     *
      * @param type The type of file system event.
      * @param oldPath The previous file or directory path.
      * @param newPath The new file or directory path (if applicable).
      */
-    void OnFileSystemEvent(int type, const wxString &oldPath, wxString newPath);
+    void OnFileSystemEvent(int type, const wxString &oldPath, const wxString &newPath);
 
     /**
      * @brief Returns the panel holding project information.
@@ -75,16 +145,22 @@ public:
     wxPanel *GetProjectInformations() const { return m_projectInformations; }
 
     /**
-     * @brief Returns the scrollable container with all project files.
+     * @brief Returns the container holding the project tree view.
      * @return Pointer to the project files container panel.
      */
-    wxScrolled<wxPanel> *GetProjectFilesContainer() const { return m_projectFilesContainer; }
+    wxPanel *GetProjectFilesContainer() const { return m_projectFilesContainer; }
 
     /**
-     * @brief Returns the currently selected file panel.
-     * @return Pointer to the selected file window.
+     * @brief Returns the owner-drawn view rendering the project tree.
+     * @return Pointer to the tree view.
      */
-    wxWindow *GetCurrentSelectedFile() const { return m_currentSelectedFile; }
+    FilesTreeView *GetFilesTreeView() const { return m_filesTreeView; }
+
+    /**
+     * @brief Returns the path of the currently highlighted file.
+     * @return The highlighted file path, empty if none.
+     */
+    wxString GetCurrentSelectedFile() const { return m_currentSelectedFile; }
 
     /**
      * @brief Opens a file in the editor panel.
@@ -106,123 +182,270 @@ public:
      */
     void ToggleDirVisibility(const wxString &componentIdentifier, bool defaultSho = false);
 
+    /**
+     * @brief Collapses every expanded directory of the project.
+     *
+     * Only the expanded part of the model is visited and the rows are rebuilt once.
+     */
+    void CollapseAll();
+
+    /**
+     * @brief Expands a directory and its subfolders down to a number of levels.
+     *
+     * Directories that are not listed yet are expanded as their listing
+     * reports them, deeper expanded directories are collapsed.
+     *
+     * @param path The directory path (the project path for the whole tree).
+     * @param levels How many directory levels are shown expanded, the directory included.
+     */
+    void ExpandToDepth(const wxString &path, int levels);
+
+    /**
+     * @brief Handles a left mouse click on a file row.
+     * @param path The path of the clicked file.
+     */
+    void OnFileLeftClick(const wxString &path);
+
+    /**
+     * @brief Handles a right mouse click on a file row.
+     * @param path The path of the clicked file.
+     */
+    void OnFileRightClick(const wxString &path);
+
+    /**
+     * @brief Handles a left mouse click on a directory row.
+     * @param path The path of the clicked directory.
+     */
+    void OnDirLeftClick(const wxString &path);
+
+    /**
+     * @brief Handles a right mouse click on a directory row.
+     * @param path The path of the clicked directory.
+     */
+    void OnDirRightClick(const wxString &path);
+
 private:
     /**
-     * @brief Creates and initializes the UI components required to represent a directory.
+     * @brief Applies a flushed batch of file system changes and rebuilds the rows once.
+     * @param groups The coalesced changes, grouped by parent directory.
+     */
+    void ApplyFileSystemChanges(const std::vector<FileSystemChangeGroup> &groups);
+
+    /**
+     * @brief Applies a single file system change to the tree model.
+     * @param parentNode The node of the directory containing the changed entry.
+     * @param change The change to apply.
+     */
+    void ApplyFileSystemChange(int parentNode, const FileSystemChange &change);
+
+    /**
+     * @brief Returns the tabs panel, looked up once.
+     */
+    Tabs *GetTabs();
+
+    /**
+     * @brief Starts listing a directory on a worker thread.
      *
-     * This method generates the visual elements needed to display a directory in the project tree.
-     * It creates the container for the directory, associates the directory path, and attaches
-     * the necessary event bindings for user interaction (expand/collapse, selection, context menu).
+     * Entries are streamed back in sorted batches and merged into the tree model,
+     * a "loading" placeholder row is shown until the listing completes. Hidden
+     * entries are skipped according to the user settings.
      *
-     * @param parent The parent window in which the directory components will be placed.
-     * @param path The filesystem path of the directory to represent.
+     * @param parentNode The tree node that receives the entries.
+     * @param path The filesystem path of the directory to list.
+     * @param revalidate Whether the children already in the model come from a
+     *        snapshot: no placeholder is shown and the children missing from
+     *        the listing are removed once it completes.
+     * @param expandDepth The reported directories shallower than this depth are
+     *        expanded as well, see ExpandToDepth().
      */
-    void CreateDirectoryComponents(wxWindow *parent, const wxString &path);
+    void CreateDirectoryComponents(int parentNode, const wxString &path, bool revalidate = false, int expandDepth = -1);
 
     /**
-     * @brief Creates a container widget for displaying a file.
-     * @param parent The parent window.
-     * @param path The path to the file.
-     * @return A pointer to the created file container widget.
+     * @brief Creates the filter box displayed above the tree.
+     * @param sizer The sizer receiving the box.
      */
-    wxWindow *CreateFileContainer(wxWindow *parent, const wxString &path);
+    void CreateFilterBar(wxSizer *sizer);
 
     /**
-     * @brief Creates a container widget for displaying a directory.
-     * @param parent The parent window.
-     * @param path The path to the directory.
-     * @param pos Optional index position within the parent sizer.
-     * @return A pointer to the created directory container widget.
+     * @brief Narrows the tree to the entries matching the filter box content.
+     *
+     * The project index is built on first use, the results are shown as soon as it is ready.
      */
-    wxWindow *CreateDirContainer(wxWindow *parent, wxString path, bool withPosition = false, int pos = 0);
+    void ApplyFilter();
 
     /**
-     * @brief Links mouse click events to the project information components.
+     * @brief Marks the project index stale unless the whole tree is watched.
      *
-     * Sets up event handlers so that clicking on specific project information UI elements
-     * triggers the appropriate click actions.
+     * Called when the filter box is focused or stops being empty, so files
+     * changed in unwatched folders show up without reopening the project.
+     * A build already under way is kept.
      */
-    void LinkClickEventToProjectInformationsComponents();
+    void MarkUnwatchedProjectIndexStale();
 
     /**
-     * @brief Handles left-click events on the project information components.
+     * @brief Applies the filter on every keystroke.
+     * @param event The text event.
+     */
+    void OnFilterTextChanged(wxCommandEvent &event);
+
+    /**
+     * @brief Clears the filter when Escape is pressed.
+     * @param event The key event.
+     */
+    void OnFilterKeyDown(wxKeyEvent &event);
+
+    /**
+     * @brief Starts building the project index as soon as the filter box is focused.
+     * @param event The focus event.
+     */
+    void OnFilterFocus(wxFocusEvent &event);
+
+    /**
+     * @brief Lists the whole project into a ProjectPathIndex on a worker thread.
      *
-     * @param event The wxMouseEvent containing information about the mouse click.
+     * Does nothing while a build is already running.
      */
-    void ProjectInformationsLeftClick(wxMouseEvent &WXUNUSED(event));
+    void BuildProjectIndex();
 
     /**
-     * @brief Handles the paint event for directory child components.
-     * @param event The wxPaintEvent triggered by the window system.
+     * @brief Installs a freshly built project index and refreshes the filter results.
+     * @param task The build task, ignored if it is not the current one.
+     * @param index The built index.
      */
-    void OnDirChildrensPaint(wxPaintEvent &event);
+    void OnProjectIndexBuilt(std::shared_ptr<DirectoryListingTask> task, std::shared_ptr<ProjectPathIndex> index);
 
     /**
-     * @brief Handles a left mouse click on a file.
-     * @param event The mouse event.
+     * @brief Cancels the running index build and drops the current index.
      */
-    void OnFileLeftClick(wxMouseEvent &event);
+    void ResetProjectIndex();
 
     /**
-     * @brief Handles a right mouse click on a file.
-     * @param event The mouse event.
+     * @brief Rebuilds the tree saved by SaveTreeState().
+     *
+     * Directories present in the snapshot are rendered at once and checked
+     * against the disk in the background, the other expanded directories are
+     * expanded as soon as their parent listing reports them. Listings saved
+     * with the current sort order are appended without searching positions.
+     *
+     * @param rootNode The root node of the freshly loaded project.
      */
-    void OnFileRightClick(wxMouseEvent &event);
+    void RestoreTreeState(int rootNode);
 
     /**
-     * @brief Handles a left mouse click on a directory.
-     * @param event The mouse event.
+     * @brief Expands a directory while restoring the saved tree state.
+     * @param node The directory node.
      */
-    void OnDirLeftClick(wxMouseEvent &event);
+    void ExpandRestoredDirectory(int node);
 
     /**
-     * @brief Handles a right mouse click on a directory.
-     * @param event The mouse event.
+     * @brief Expands the directories of a subtree shallower than a depth and collapses the deeper ones.
+     * @param node The subtree root node.
+     * @param maxDepth Directories with a smaller depth are expanded.
      */
-    void OnDirRightClick(wxMouseEvent &event);
+    void ApplyExpandDepth(int node, int maxDepth);
 
     /**
-     * @brief Handles the paint event for custom rendering.
-     * @param event The paint event.
+     * @brief Collapses a directory together with its expanded descendants.
+     *
+     * Pending listings of the subtree are cancelled and, unless the whole
+     * tree is watched, the subtree is unloaded.
+     *
+     * @param node The directory node.
      */
-    void OnPaint(wxPaintEvent &event);
+    void CollapseDirectory(int node);
 
     /**
-     * @brief Adjusts the size of a specific container to fit its contents.
-     * @param componentIdentifier The unique identifier (path) of the component.
+     * @brief Merges a batch produced by a background listing into the tree model.
+     * @param task The listing the batch belongs to.
+     * @param path The listed directory path.
+     * @param entries The sorted entries of the batch.
+     * @param finished Whether this is the last batch of the listing.
+     * @param failed Whether the directory could not be read.
      */
-    void AdjustContainerSize(wxWindow *target, bool reduceSize = false);
+    void OnDirectoryListingBatch(std::shared_ptr<DirectoryListingTask> task, const wxString &path,
+                                 std::shared_ptr<std::vector<DirectoryListingEntry>> entries, bool finished, bool failed);
 
     /**
-     * @brief Handles a user request to rename a directory.
-     * @param event The associated command event.
+     * @brief Cancels the background listing of a directory, if any.
+     * @param path The listed directory path.
      */
-    void OnRenameDirRequested(wxCommandEvent &WXUNUSED(event));
+    void CancelDirectoryListing(const wxString &path);
 
     /**
-     * @brief Handles a user request to rename a file.
-     * @param event The associated command event.
+     * @brief Cancels every pending background listing.
      */
-    void OnRenameFileRequested(wxCommandEvent &WXUNUSED(event));
+    void CancelAllDirectoryListings();
 
     /**
-     * @brief Changes the background color of a specific file component.
-     * @param componentIdentifier The unique identifier (path) of the component.
-     * @param color The wxColour to apply.
+     * @brief Tells whether the whole project tree is watched (fileWatcher/watchWholeTree setting).
+     *
+     * Otherwise only the project root and the expanded directories are watched,
+     * and collapsed directories are unloaded since their content is no longer tracked.
      */
-    void ChangeFileBackground(const wxString &componentIdentifier, wxColour color);
+    static bool IsWatchingWholeTree();
 
     /**
-     * @brief Handles the mouse entering a component area.
-     * @param event The mouse event.
+     * @brief Adds an expanded directory to the file system watcher.
+     * @param path The directory path, ending with the path separator.
      */
-    void OnComponentMouseEnter(wxMouseEvent &event);
+    void WatchDirectory(const wxString &path);
 
     /**
-     * @brief Handles the mouse leaving a component area.
-     * @param event The mouse event.
+     * @brief Stops watching a directory and every watched directory below it.
+     * @param path The directory path, ending with the path separator.
+     * @param removeWatches False when the directory no longer exists and its watches are already gone.
      */
-    void OnComponentMouseExit(wxMouseEvent &event);
+    void UnwatchDirectories(const wxString &path, bool removeWatches = true);
+
+    /**
+     * @brief Tells whether an entry must be shown according to the hidden files settings and the IgnoreEngine.
+     * @param path The entry absolute path.
+     * @param name The entry name.
+     * @param isDir Whether the entry is a directory.
+     * @param showHiddenDirs Value of the view/showHiddenDirs setting.
+     * @param showHiddenFiles Value of the view/showHiddenFiles setting.
+     */
+    static bool IsEntryVisible(const wxString &path, const wxString &name, bool isDir, bool showHiddenDirs, bool showHiddenFiles);
+
+    /**
+     * @brief Links mouse click events to the project information components.
+     *
+     * Sets up event handlers so that clicking on specific project information UI elements
+     * triggers the appropriate click actions.
+     */
+    void LinkClickEventToProjectInformationsComponents();
+
+    /**
+     * @brief Handles left-click events on the project information components.
+     *
+     * @param event The wxMouseEvent containing information about the mouse click.
+     */
+    void ProjectInformationsLeftClick(wxMouseEvent &WXUNUSED(event));
+
+    /**
+     * @brief Handles right-click events on the project information components.
+     *
+     * @param event The wxMouseEvent containing information about the mouse click.
+     */
+    void ProjectInformationsRightClick(wxMouseEvent &WXUNUSED(event));
+
+    /**
+     * @brief Handles the paint event for custom rendering.
+     * @param event The paint event.
+     */
+    void OnPaint(wxPaintEvent &event);
+
+    /**
+     * @brief Handles a user request to rename a directory.
+     * @param event The associated command event.
+     */
+    void OnRenameDirRequested(wxCommandEvent &WXUNUSED(event));
+
+    /**
+     * @brief Handles a user request to rename a file.
+     * @param event The associated command event.
+     */
+    void OnRenameFileRequested(wxCommandEvent &WXUNUSED(event));
 
     /**
      * @brief Handles mouse hover enter events over the project information area.
@@ -241,9 +464,14 @@ private:
     wxPanel *m_projectInformations = nullptr;
 
     /**
-     * @brief Scrollable container holding project files and directories.
+     * @brief Container holding the tree view (or the open folder button when no project is set).
      */
-    wxScrolled<wxPanel> *m_projectFilesContainer = nullptr;
+    wxPanel *m_projectFilesContainer = nullptr;
+
+    /**
+     * @brief Owner-drawn view rendering the project files and directories.
+     */
+    FilesTreeView *m_filesTreeView = nullptr;
 
     /**
      * @brief Text label showing the project name.
@@ -256,15 +484,65 @@ private:
     wxStaticBitmap *m_projectInformationsNameArrow = nullptr;
 
     /**
-     * @brief Weak reference to the currently selected file window.
+     * @brief Path of the currently highlighted file.
+     */
+    wxString m_currentSelectedFile;
+
+    /**
+     * @brief Tabs panel, resolved by GetTabs() (it lives as long as the main frame).
+     */
+    Tabs *m_tabs = nullptr;
+
+    /**
+     * @brief Background listings in progress, keyed by directory path.
+     */
+    std::unordered_map<wxString, std::shared_ptr<DirectoryListingTask>> m_directoryListings;
+
+    /**
+     * @brief Expanded directories added to the file system watcher.
      */
-    wxWeakRef<wxWindow> m_currentSelectedFile;
+    std::unordered_set<wxString> m_watchedDirectories;
+
+    /**
+     * @brief Saved expanded directories not yet reported by their parent listing.
+     */
+    std::unordered_set<wxString> m_pendingExpandedDirs;
+
+    /**
+     * @brief Debounces the watcher events before they are applied to the tree.
+     */
+    FileSystemEventBatcher m_fileSystemEventBatcher;
 
     /**
      * @brief Auxiliary tools panel associated with the file tree.
      */
     ProjectInfosTools *m_projectInfosTools = nullptr;
 
+    /**
+     * @brief Filter box narrowing the tree to the matching files.
+     */
+    wxTextCtrl *m_filterBar = nullptr;
+
+    /**
+     * @brief Paths of the whole project, searched by the filter box.
+     */
+    std::shared_ptr<ProjectPathIndex> m_projectIndex;
+
+    /**
+     * @brief Running build of the project index, null when idle.
+     */
+    std::shared_ptr<DirectoryListingTask> m_projectIndexTask;
+
+    /**
+     * @brief Whether the project changed on disk since the index build started.
+     */
+    bool m_projectIndexStale = true;
+
+    /**
+     * @brief Directory levels expanded by the "Expand Subfolders" context menu entry.
+     */
+    static constexpr int EXPAND_SUBFOLDERS_LEVELS = 3;
+
     wxDECLARE_NO_COPY_CLASS(FilesTree);
     wxDECLARE_EVENT_TABLE();
 };
@@ -6,5 +6,6 @@ wxBEGIN_EVENT_TABLE(FilesTree, wxPanel)
 	EVT_MENU(+Event::File::DeleteFileEvent, FilesTree::OnDeleteFileRequested)
 	EVT_MENU(+Event::File::RenameDir, FilesTree::OnRenameDirRequested)
 	EVT_MENU(+Event::File::DeleteDir, FilesTree::OnDeleteDirRequested)
+	EVT_MENU(+Event::File::ExpandSubfolders, FilesTree::OnExpandSubfoldersRequested)
 	EVT_PAINT(FilesTree::OnPaint)
 wxEND_EVENT_TABLE()
\ No newline at end of file
@@ -0,0 +1,567 @@
+#include "filesTreeView.hpp"
+#include "gui/panels/filesTree/filesTree.hpp"
+#include "gui/panels/filesTree/projectPathIndex/projectPathIndex.hpp"
+
+#include "themesManager/themesManager.hpp"
+#include "iconsCache/iconsCache.hpp"
+#include "platformInfos/platformInfos.hpp"
+
+#include <wx/dcbuffer.h>
+#include <algorithm>
+
+FilesTreeView::FilesTreeView(wxWindow *parent, FilesTree *owner, wxWindowID ID)
+    : wxVScrolledWindow(parent, ID, wxDefaultPosition, wxDefaultSize, wxVSCROLL | wxFULL_REPAINT_ON_RESIZE),
+      m_owner(owner)
+{
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetBackgroundColour(ThemesManager::Get().GetColor("main"));
+
+    m_arrowCollapsed = IconsCache::Get().GetIcon("dir_arrow.png", 0, GetDPIScaleFactor());
+    m_arrowExpanded = IconsCache::Get().GetIcon("dir_arrow.png", 90, GetDPIScaleFactor());
+
+    SetRowCount(0);
+}
+
+void FilesTreeView::Clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_rows.clear();
+    m_pathIndex.clear();
+    m_rootNode = -1;
+    m_selectedNode = -1;
+    m_hoveredNode = -1;
+    m_rowsDirty = false;
+    m_filterIndex.reset();
+    m_filterRows.clear();
+
+    UnsetToolTip();
+    SetRowCount(0);
+    Refresh();
+}
+
+int FilesTreeView::SetRoot(const wxString &path)
+{
+    Clear();
+
+    FilesTreeNode root;
+    root.path = path;
+    root.name = wxFileNameFromPath(wxString(path).RemoveLast());
+    root.parent = -1;
+    root.depth = -1;
+    root.isDir = true;
+    root.expanded = true;
+
+    m_nodes.push_back(std::move(root));
+    m_rootNode = 0;
+    m_pathIndex[path] = m_rootNode;
+    return m_rootNode;
+}
+
+int FilesTreeView::InsertNode(int parent, const wxString &path, bool isDir, int position, std::string sortKey)
+{
+    if (parent < 0 || parent >= (int)m_nodes.size() || !m_nodes[parent].alive)
+        return -1;
+
+    FilesTreeNode node;
+    node.path = path;
+    node.isDir = isDir;
+    node.parent = parent;
+    node.depth = m_nodes[parent].depth + 1;
+
+    if (isDir && path.Last() != PlatformInfos::OsPathSeparator())
+        node.path.Append(PlatformInfos::OsPathSeparator());
+
+    node.name = isDir ? wxFileNameFromPath(wxString(node.path).RemoveLast()) : wxFileNameFromPath(path);
+    node.sortKey = sortKey.empty() ? MakeSortKey(node.name, m_sortOrder) : std::move(sortKey);
+
+    int index;
+    if (!m_freeNodes.empty())
+    {
+        index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        m_nodes[index] = std::move(node);
+    }
+    else
+    {
+        index = (int)m_nodes.size();
+        m_nodes.push_back(std::move(node));
+    }
+
+    m_pathIndex[m_nodes[index].path] = index;
+
+    auto &siblings = m_nodes[parent].children;
+    if (position < 0 || position >= (int)siblings.size())
+        siblings.push_back(index);
+    else
+        siblings.insert(siblings.begin() + position, index);
+
+    return index;
+}
+
+void FilesTreeView::ReleaseNode(int node)
+{
+    for (int child : m_nodes[node].children)
+        ReleaseNode(child);
+
+    if (m_selectedNode == node)
+        m_selectedNode = -1;
+    if (m_hoveredNode == node)
+        m_hoveredNode = -1;
+
+    auto indexed = m_pathIndex.find(m_nodes[node].path);
+    if (indexed != m_pathIndex.end() && indexed->second == node)
+        m_pathIndex.erase(indexed);
+
+    m_nodes[node] = FilesTreeNode();
+    m_nodes[node].alive = false;
+    m_freeNodes.push_back(node);
+}
+
+void FilesTreeView::RemoveNode(int node)
+{
+    if (node < 0 || node >= (int)m_nodes.size() || !m_nodes[node].alive || node == m_rootNode)
+        return;
+
+    int position = FindChildPosition(node);
+    if (position >= 0)
+    {
+        auto &siblings = m_nodes[m_nodes[node].parent].children;
+        siblings.erase(siblings.begin() + position);
+    }
+
+    ReleaseNode(node);
+}
+
+void FilesTreeView::RemoveChildren(int node)
+{
+    if (node < 0 || node >= (int)m_nodes.size() || !m_nodes[node].alive)
+        return;
+
+    std::vector<int> children;
+    children.swap(m_nodes[node].children);
+    for (int child : children)
+        ReleaseNode(child);
+}
+
+std::string FilesTreeView::MakeSortKey(const wxString &name, FilesTreeSortOrder order)
+{
+    const std::string original = name.utf8_string();
+    if (order == FilesTreeSortOrder::Ordinal)
+        return original;
+
+    const std::string folded = name.Lower().utf8_string();
+
+    std::string key;
+    key.reserve(folded.size() + original.size() + 8);
+
+    for (size_t i = 0; i < folded.size();)
+    {
+        if (folded[i] < '0' || folded[i] > '9')
+        {
+            key.push_back(folded[i++]);
+            continue;
+        }
+
+        size_t start = i;
+        while (i < folded.size() && folded[i] >= '0' && folded[i] <= '9')
+            ++i;
+        while (start + 1 < i && folded[start] == '0')
+            ++start;
+
+        // A digit run is stored as its length followed by its digits, so longer numbers sort after shorter ones
+        size_t length = std::min<size_t>(i - start, 255);
+        key.push_back('0');
+        key.push_back((char)length);
+        key.append(folded, start, i - start);
+    }
+
+    key.push_back('\0');
+    key.append(original);
+    return key;
+}
+
+bool FilesTreeView::IsSortedBefore(const FilesTreeNode &node, const std::string &sortKey, bool isDir)
+{
+    if (node.isDir != isDir)
+        return node.isDir;
+    return node.sortKey < sortKey;
+}
+
+int FilesTreeView::FindInsertPosition(int parent, const wxString &name, bool isDir) const
+{
+    return FindSortedPosition(parent, MakeSortKey(name, m_sortOrder), isDir);
+}
+
+int FilesTreeView::FindSortedPosition(int parent, const std::string &sortKey, bool isDir) const
+{
+    const auto &siblings = m_nodes[parent].children;
+    auto position = std::lower_bound(siblings.begin(), siblings.end(), 0, [&](int sibling, int)
+                                     { return IsSortedBefore(m_nodes[sibling], sortKey, isDir); });
+
+    return (int)(position - siblings.begin());
+}
+
+int FilesTreeView::FindChildPosition(int node) const
+{
+    if (node < 0 || node >= (int)m_nodes.size() || !m_nodes[node].alive || m_nodes[node].parent < 0)
+        return -1;
+
+    const auto &target = m_nodes[node];
+    const auto &siblings = m_nodes[target.parent].children;
+
+    int position = FindSortedPosition(target.parent, target.sortKey, target.isDir);
+    if (position < (int)siblings.size() && siblings[position] == node)
+        return position;
+
+    auto linear = std::find(siblings.begin(), siblings.end(), node);
+    return linear != siblings.end() ? (int)(linear - siblings.begin()) : -1;
+}
+
+void FilesTreeView::RenameNode(int node, const wxString &newPath, int newParent)
+{
+    if (node < 0 || node >= (int)m_nodes.size() || !m_nodes[node].alive || node == m_rootNode)
+        return;
+    if (newParent < 0 || newParent >= (int)m_nodes.size() || !m_nodes[newParent].alive)
+        newParent = m_nodes[node].parent;
+
+    int position = FindChildPosition(node);
+    if (position >= 0)
+    {
+        auto &oldSiblings = m_nodes[m_nodes[node].parent].children;
+        oldSiblings.erase(oldSiblings.begin() + position);
+    }
+
+    auto &target = m_nodes[node];
+    wxString oldPath = target.path;
+    const int depthOffset = m_nodes[newParent].depth + 1 - target.depth;
+
+    m_pathIndex.erase(oldPath);
+    target.path = newPath;
+    if (target.isDir && newPath.Last() != PlatformInfos::OsPathSeparator())
+        target.path.Append(PlatformInfos::OsPathSeparator());
+    m_pathIndex[target.path] = node;
+
+    target.name = target.isDir ? wxFileNameFromPath(wxString(target.path).RemoveLast()) : wxFileNameFromPath(target.path);
+    target.sortKey = MakeSortKey(target.name, m_sortOrder);
+    target.icon = wxNullBitmap;
+    target.parent = newParent;
+    target.depth += depthOffset;
+
+    auto &newSiblings = m_nodes[newParent].children;
+    newSiblings.insert(newSiblings.begin() + FindSortedPosition(newParent, target.sortKey, target.isDir), node);
+
+    if (!m_nodes[node].isDir)
+        return;
+
+    std::vector<int> pending(m_nodes[node].children.begin(), m_nodes[node].children.end());
+    while (!pending.empty())
+    {
+        int current = pending.back();
+        pending.pop_back();
+
+        auto &child = m_nodes[current];
+        child.depth += depthOffset;
+        if (child.path.StartsWith(oldPath))
+        {
+            m_pathIndex.erase(child.path);
+            child.path = m_nodes[node].path + child.path.Mid(oldPath.length());
+            m_pathIndex[child.path] = current;
+        }
+
+        pending.insert(pending.end(), child.children.begin(), child.children.end());
+    }
+}
+
+int FilesTreeView::FindNode(const wxString &path) const
+{
+    auto found = m_pathIndex.find(path);
+    return found != m_pathIndex.end() ? found->second : -1;
+}
+
+void FilesTreeView::SetExpanded(int node, bool expanded)
+{
+    if (node < 0 || node >= (int)m_nodes.size() || !m_nodes[node].isDir)
+        return;
+    m_nodes[node].expanded = expanded;
+}
+
+void FilesTreeView::SetSelectedNode(int node)
+{
+    if (m_selectedNode == node)
+        return;
+    m_selectedNode = node;
+    Refresh();
+}
+
+void FilesTreeView::AppendVisibleRows(int node)
+{
+    for (int child : m_nodes[node].children)
+    {
+        m_rows.push_back(child);
+        if (m_nodes[child].isDir && m_nodes[child].expanded)
+            AppendVisibleRows(child);
+    }
+
+    if (m_nodes[node].loading && !m_nodes[node].loaded)
+        m_rows.push_back(~node);
+}
+
+void FilesTreeView::RebuildRows()
+{
+    m_rowsDirty = true;
+}
+
+void FilesTreeView::UpdateRows()
+{
+    if (!m_rowsDirty)
+        return;
+    m_rowsDirty = false;
+
+    m_rows.clear();
+    if (m_rootNode >= 0 && !m_filterIndex)
+        AppendVisibleRows(m_rootNode);
+
+    SetRowCount(m_filterIndex ? m_filterRows.size() : m_rows.size());
+    RefreshAll();
+}
+
+void FilesTreeView::SetFilterResults(std::shared_ptr<ProjectPathIndex> index, std::vector<int> rows)
+{
+    m_filterIndex = std::move(index);
+    m_filterRows = std::move(rows);
+    m_hoveredNode = -1;
+    UnsetToolTip();
+
+    m_rowsDirty = true;
+    UpdateRows();
+    ScrollToRow(0);
+}
+
+void FilesTreeView::ClearFilterResults()
+{
+    if (!m_filterIndex)
+        return;
+
+    m_filterIndex.reset();
+    m_filterRows.clear();
+    m_hoveredNode = -1;
+    UnsetToolTip();
+
+    m_rowsDirty = true;
+    UpdateRows();
+}
+
+void FilesTreeView::OnIdle(wxIdleEvent &event)
+{
+    UpdateRows();
+    event.Skip();
+}
+
+wxCoord FilesTreeView::OnGetRowHeight(size_t WXUNUSED(row)) const
+{
+    return FromDIP(ROW_HEIGHT);
+}
+
+int FilesTreeView::HitTest(const wxPoint &position)
+{
+    UpdateRows();
+
+    int row = VirtualHitTest(position.y);
+    if (row == wxNOT_FOUND)
+        return -1;
+    if (m_filterIndex)
+        return row < (int)m_filterRows.size() ? m_filterRows[row] : -1;
+    if (row >= (int)m_rows.size() || m_rows[row] < 0)
+        return -1;
+    return m_rows[row];
+}
+
+wxString FilesTreeView::GetItemPath(int item, bool &isDir) const
+{
+    if (m_filterIndex)
+    {
+        isDir = m_filterIndex->GetEntry(item).isDir;
+        return m_filterIndex->GetPath(item);
+    }
+
+    isDir = m_nodes[item].isDir;
+    return m_nodes[item].path;
+}
+
+const wxBitmap &FilesTreeView::GetNodeIcon(int node)
+{
+    auto &target = m_nodes[node];
+    if (!target.icon.IsOk())
+        target.icon = IconsCache::Get().GetFileIcon(target.path, GetDPIScaleFactor());
+
+    return target.icon;
+}
+
+void FilesTreeView::OnPaint(wxPaintEvent &WXUNUSED(event))
+{
+    UpdateRows();
+
+    wxAutoBufferedPaintDC dc(this);
+
+    dc.SetBackground(GetBackgroundColour());
+    dc.Clear();
+
+    if (m_filterIndex ? m_filterRows.empty() : m_rows.empty())
+        return;
+
+    const wxColour placeholderColor = ThemesManager::Get().GetColor("secondaryText");
+    m_highlightColor = ThemesManager::Get().GetColor("selectedFile");
+    m_borderColor = ThemesManager::Get().GetColor("border");
+    const int rowHeight = FromDIP(ROW_HEIGHT);
+
+    dc.SetFont(GetFont());
+    dc.SetTextForeground(GetForegroundColour());
+    const int textHeight = dc.GetCharHeight();
+
+    const size_t first = GetVisibleRowsBegin();
+
+    if (m_filterIndex)
+    {
+        const wxString selectedPath = m_selectedNode >= 0 ? m_nodes[m_selectedNode].path : wxString();
+        const size_t last = std::min(GetVisibleRowsEnd(), m_filterRows.size());
+
+        for (size_t row = first; row < last; ++row)
+        {
+            int entry = m_filterRows[row];
+            const auto &target = m_filterIndex->GetEntry(entry);
+            const int y = (int)(row - first) * rowHeight;
+
+            if (target.isDir)
+            {
+                DrawRow(dc, y, target.depth, true, true, m_filterIndex->GetName(entry), wxNullBitmap, entry == m_hoveredNode);
+                continue;
+            }
+
+            const wxString path = m_filterIndex->GetPath(entry);
+            DrawRow(dc, y, target.depth, false, false, m_filterIndex->GetName(entry),
+                    IconsCache::Get().GetFileIcon(path, GetDPIScaleFactor()), entry == m_hoveredNode || path == selectedPath);
+        }
+        return;
+    }
+
+    const size_t last = std::min(GetVisibleRowsEnd(), m_rows.size());
+
+    for (size_t row = first; row < last; ++row)
+    {
+        const int y = (int)(row - first) * rowHeight;
+
+        if (m_rows[row] < 0)
+        {
+            const int depth = m_nodes[~m_rows[row]].depth + 1;
+            dc.SetTextForeground(placeholderColor);
+            dc.DrawText(_("Loading..."), FromDIP(LEFT_MARGIN + depth * INDENT), y + (rowHeight - textHeight) / 2);
+            dc.SetTextForeground(GetForegroundColour());
+            continue;
+        }
+
+        int index = m_rows[row];
+        const auto &node = m_nodes[index];
+        DrawRow(dc, y, node.depth, node.isDir, node.expanded, node.name,
+                node.isDir ? wxNullBitmap : GetNodeIcon(index), index == m_selectedNode || index == m_hoveredNode);
+    }
+}
+
+void FilesTreeView::DrawRow(wxDC &dc, int y, int depth, bool isDir, bool expanded, const wxString &name, const wxBitmap &icon, bool highlighted)
+{
+    const int rowHeight = FromDIP(ROW_HEIGHT);
+    const int textHeight = dc.GetCharHeight();
+
+    if (highlighted)
+    {
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(m_highlightColor);
+        dc.DrawRectangle(0, y, GetClientSize().x, rowHeight);
+    }
+
+    dc.SetPen(wxPen(m_borderColor, 1, wxPENSTYLE_DOT));
+    for (int level = 1; level <= depth; ++level)
+        dc.DrawLine(FromDIP(level * INDENT), y, FromDIP(level * INDENT), y + rowHeight);
+
+    int x = FromDIP(LEFT_MARGIN + depth * INDENT);
+
+    if (isDir)
+    {
+        const wxBitmap &arrow = expanded ? m_arrowExpanded : m_arrowCollapsed;
+        if (arrow.IsOk())
+        {
+            dc.DrawBitmap(arrow, x, y + (rowHeight - arrow.GetLogicalHeight()) / 2, true);
+            x += arrow.GetLogicalWidth();
+        }
+        x += FromDIP(4);
+    }
+    else
+    {
+        if (icon.IsOk())
+        {
+            dc.DrawBitmap(icon, x, y + (rowHeight - icon.GetLogicalHeight()) / 2, true);
+            x += icon.GetLogicalWidth();
+        }
+        x += FromDIP(5);
+    }
+
+    dc.DrawText(name, x, y + (rowHeight - textHeight) / 2);
+}
+
+void FilesTreeView::OnMouseMotion(wxMouseEvent &event)
+{
+    int node = HitTest(event.GetPosition());
+    if (node != m_hoveredNode)
+    {
+        m_hoveredNode = node;
+        bool isDir = false;
+        if (node >= 0)
+            SetToolTip(GetItemPath(node, isDir));
+        else
+            UnsetToolTip();
+        Refresh();
+    }
+    event.Skip();
+}
+
+void FilesTreeView::OnMouseLeave(wxMouseEvent &event)
+{
+    if (m_hoveredNode >= 0)
+    {
+        m_hoveredNode = -1;
+        Refresh();
+    }
+    event.Skip();
+}
+
+void FilesTreeView::OnLeftUp(wxMouseEvent &event)
+{
+    int node = HitTest(event.GetPosition());
+    if (node < 0 || !m_owner)
+        return;
+
+    bool isDir = false;
+    wxString path = GetItemPath(node, isDir);
+    if (isDir)
+    {
+        // Filtered directories always show their matches, they cannot be collapsed
+        if (!m_filterIndex)
+            m_owner->OnDirLeftClick(path);
+    }
+    else
+        m_owner->OnFileLeftClick(path);
+}
+
+void FilesTreeView::OnRightUp(wxMouseEvent &event)
+{
+    int node = HitTest(event.GetPosition());
+    if (node < 0 || !m_owner)
+        return;
+
+    bool isDir = false;
+    wxString path = GetItemPath(node, isDir);
+    if (isDir)
+        m_owner->OnDirRightClick(path);
+    else
+        m_owner->OnFileRightClick(path);
+}
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <wx/wx.h>
+#include <wx/vscroll.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class FilesTree;
+class ProjectPathIndex;
+
+/**
+ * @enum FilesTreeSortOrder
+ * @brief Ordering of the entries of a directory (view/filesTreeSortOrder setting).
+ */
+enum class FilesTreeSortOrder
+{
+    Natural, ///< Case-insensitive, numbers compared by value ("file2" before "file10")
+    Ordinal  ///< Byte-wise, case-sensitive
+};
+
+/**
+ * @struct FilesTreeNode
+ * @brief A single file or directory entry of the project tree model.
+ *
+ * Nodes live in a flat array owned by FilesTreeView and reference each other
+ * by index, so expanding a folder only appends plain structs instead of
+ * creating native windows.
+ */
+struct FilesTreeNode
+{
+    wxString path;             ///< Absolute path (directories end with the path separator)
+    wxString name;             ///< Display name
+    std::string sortKey;       ///< Precomputed key ordering the node among its siblings
+    int parent = -1;           ///< Index of the parent node, -1 for the root
+    int depth = 0;             ///< Nesting level, the root children have depth 0
+    bool isDir = false;        ///< Whether the node represents a directory
+    bool expanded = false;     ///< Whether the directory children are visible
+    bool loaded = false;       ///< Whether the directory content was already listed
+    bool loading = false;      ///< Whether a background listing is still streaming (or revalidating) entries
+    bool alive = true;         ///< False once the node slot has been released
+    std::vector<int> children; ///< Child node indices, kept sorted directories first then by sort key
+    wxBitmap icon;             ///< File icon shared from the IconsCache, resolved on first paint
+};
+
+/**
+ * @class FilesTreeView
+ * @brief Virtual-scrolling, owner-drawn view of the project tree.
+ *
+ * The whole tree is rendered by a single window: only the rows inside the
+ * visible range are painted, and mouse events are resolved to nodes by
+ * hit-testing the row under the cursor. User interactions are forwarded to
+ * the owning FilesTree, which keeps the open/rename/delete/context-menu logic.
+ */
+class FilesTreeView : public wxVScrolledWindow
+{
+public:
+    /**
+     * @brief Constructs the tree view.
+     * @param parent The parent window.
+     * @param owner The FilesTree receiving the user interactions.
+     * @param ID The window identifier.
+     */
+    FilesTreeView(wxWindow *parent, FilesTree *owner, wxWindowID ID = wxID_ANY);
+
+    /**
+     * @brief Removes every node and resets the view to an empty state.
+     */
+    void Clear();
+
+    /**
+     * @brief Clears the model and creates the (hidden) root node.
+     * @param path The project root path.
+     * @return The index of the root node.
+     */
+    int SetRoot(const wxString &path);
+
+    /**
+     * @brief Returns the index of the root node, or -1 when no project is loaded.
+     */
+    int GetRootNode() const { return m_rootNode; }
+
+    /**
+     * @brief Creates a node under the given parent.
+     * @param parent Index of the parent directory node.
+     * @param path Absolute path of the entry.
+     * @param isDir Whether the entry is a directory.
+     * @param position Insertion index among the parent children, -1 to append.
+     * @param sortKey Precomputed sort key of the entry, computed from its name when empty.
+     * @return The index of the new node.
+     */
+    int InsertNode(int parent, const wxString &path, bool isDir, int position = -1, std::string sortKey = std::string());
+
+    /**
+     * @brief Removes a node together with its whole subtree.
+     * @param node Index of the node to remove.
+     */
+    void RemoveNode(int node);
+
+    /**
+     * @brief Removes every child of a directory node.
+     * @param node Index of the directory node.
+     */
+    void RemoveChildren(int node);
+
+    /**
+     * @brief Finds where an entry belongs among the children of a directory.
+     *
+     * Children are kept directories first, then files, each group sorted by
+     * sort key, so the slot is found by binary search.
+     *
+     * @param parent Index of the directory node.
+     * @param name Display name of the entry.
+     * @param isDir Whether the entry is a directory.
+     * @return The index among the parent children where the entry must be inserted.
+     */
+    int FindInsertPosition(int parent, const wxString &name, bool isDir) const;
+
+    /**
+     * @brief Same as FindInsertPosition(), with an already computed sort key.
+     * @param parent Index of the directory node.
+     * @param sortKey Sort key of the entry, see MakeSortKey().
+     * @param isDir Whether the entry is a directory.
+     */
+    int FindSortedPosition(int parent, const std::string &sortKey, bool isDir) const;
+
+    /**
+     * @brief Computes the key ordering an entry among its siblings.
+     *
+     * Comparing two keys byte-wise gives the requested order, so the key is
+     * computed once per entry instead of on every comparison. The name is
+     * appended to the key, so two different names never have the same key.
+     * Safe to call from a worker thread.
+     *
+     * @param name The entry name.
+     * @param order The requested ordering.
+     */
+    static std::string MakeSortKey(const wxString &name, FilesTreeSortOrder order);
+
+    /**
+     * @brief Selects the ordering of the entries, must be set before nodes are inserted.
+     * @param order The new ordering.
+     */
+    void SetSortOrder(FilesTreeSortOrder order) { m_sortOrder = order; }
+
+    /**
+     * @brief Returns the ordering of the entries.
+     */
+    FilesTreeSortOrder GetSortOrder() const { return m_sortOrder; }
+
+    /**
+     * @brief Finds the slot of a node among the children of its parent.
+     *
+     * Uses the same binary search as FindInsertPosition(), so no linear scan is needed.
+     *
+     * @param node Index of the child node.
+     * @return The index of the node in its parent children, or -1 if it is not linked.
+     */
+    int FindChildPosition(int node) const;
+
+    /**
+     * @brief Changes the path of a node, updating the paths of its descendants.
+     *
+     * The node is moved to its sorted slot, under a new parent if one is given.
+     *
+     * @param node Index of the node to rename.
+     * @param newPath The new absolute path.
+     * @param newParent Index of the new parent directory node, -1 to keep the current one.
+     */
+    void RenameNode(int node, const wxString &newPath, int newParent = -1);
+
+    /**
+     * @brief Finds the node representing the given path in constant time.
+     * @param path Absolute path (directories must end with the path separator).
+     * @return The node index, or -1 if the path is not part of the model.
+     */
+    int FindNode(const wxString &path) const;
+
+    /**
+     * @brief Gives access to a node of the model.
+     * @param node A valid node index.
+     */
+    FilesTreeNode &GetNode(int node) { return m_nodes[node]; }
+    const FilesTreeNode &GetNode(int node) const { return m_nodes[node]; }
+
+    /**
+     * @brief Returns the number of node slots, including released ones.
+     */
+    size_t GetNodeCount() const { return m_nodes.size(); }
+
+    /**
+     * @brief Expands or collapses a directory node.
+     * @param node Index of the directory node.
+     * @param expanded The new state.
+     */
+    void SetExpanded(int node, bool expanded);
+
+    /**
+     * @brief Sets the highlighted (currently open) node.
+     * @param node The node index, or -1 to clear the highlight.
+     */
+    void SetSelectedNode(int node);
+
+    /**
+     * @brief Returns the highlighted node, or -1.
+     */
+    int GetSelectedNode() const { return m_selectedNode; }
+
+    /**
+     * @brief Marks the visible rows as outdated.
+     *
+     * The rows are recomputed in a single pass at idle time (or before the next
+     * paint or hit test), so a burst of expands, collapses or watcher updates
+     * costs one relayout.
+     */
+    void RebuildRows();
+
+    /**
+     * @brief Recomputes the visible rows immediately if they are outdated.
+     */
+    void UpdateRows();
+
+    /**
+     * @brief Shows the result of a filter instead of the tree model.
+     *
+     * The rows reference entries of the index rather than nodes, so matches in
+     * directories that were never expanded are shown without loading them.
+     *
+     * @param index The index the rows were computed from.
+     * @param rows The entry indices to display, see ProjectPathIndex::Filter().
+     */
+    void SetFilterResults(std::shared_ptr<ProjectPathIndex> index, std::vector<int> rows);
+
+    /**
+     * @brief Goes back to displaying the tree model.
+     */
+    void ClearFilterResults();
+
+    /**
+     * @brief Tells whether filter results are displayed.
+     */
+    bool IsFiltering() const { return m_filterIndex != nullptr; }
+
+private:
+    /**
+     * @brief Returns the fixed height of every row.
+     */
+    virtual wxCoord OnGetRowHeight(size_t row) const override;
+
+    /**
+     * @brief Appends the visible descendants of a node to the row list.
+     * @param node Index of the node whose children are appended.
+     */
+    void AppendVisibleRows(int node);
+
+    /**
+     * @brief Tells whether a node is sorted before the given entry.
+     * @param node The node compared.
+     * @param sortKey Sort key of the entry.
+     * @param isDir Whether the entry is a directory.
+     */
+    static bool IsSortedBefore(const FilesTreeNode &node, const std::string &sortKey, bool isDir);
+
+    /**
+     * @brief Releases a node slot and every slot of its subtree.
+     * @param node Index of the node to release.
+     */
+    void ReleaseNode(int node);
+
+    /**
+     * @brief Returns the node painted at the given window position.
+     * @param position Position in client coordinates.
+     * @return The node index (the index entry while filtering), or -1 if no row is under the position.
+     */
+    int HitTest(const wxPoint &position);
+
+    /**
+     * @brief Returns the absolute path of a hit-tested row.
+     * @param item A node index, or an index entry while filtering.
+     * @param isDir Receives whether the row is a directory.
+     */
+    wxString GetItemPath(int item, bool &isDir) const;
+
+    /**
+     * @brief Paints a single row.
+     * @param dc The device context.
+     * @param y Top of the row.
+     * @param depth Nesting level of the entry.
+     * @param isDir Whether the entry is a directory.
+     * @param expanded Whether the directory arrow is drawn expanded.
+     * @param name The displayed name.
+     * @param icon File icon, ignored for directories.
+     * @param highlighted Whether the row background is highlighted.
+     */
+    void DrawRow(wxDC &dc, int y, int depth, bool isDir, bool expanded, const wxString &name, const wxBitmap &icon, bool highlighted);
+
+    /**
+     * @brief Returns the icon painted next to a file node, resolving it on first use.
+     * @param node Index of the file node.
+     */
+    const wxBitmap &GetNodeIcon(int node);
+
+    /**
+     * @brief Applies the pending row update once the event queue is empty.
+     * @param event The idle event.
+     */
+    void OnIdle(wxIdleEvent &event);
+
+    /**
+     * @brief Paints the rows inside the visible range.
+     * @param event The paint event.
+     */
+    void OnPaint(wxPaintEvent &event);
+
+    /**
+     * @brief Tracks the hovered row and updates its tooltip.
+     * @param event The mouse event.
+     */
+    void OnMouseMotion(wxMouseEvent &event);
+
+    /**
+     * @brief Clears the hovered row when the cursor leaves the view.
+     * @param event The mouse event.
+     */
+    void OnMouseLeave(wxMouseEvent &event);
+
+    /**
+     * @brief Opens the clicked file or toggles the clicked directory.
+     * @param event The mouse event.
+     */
+    void OnLeftUp(wxMouseEvent &event);
+
+    /**
+     * @brief Shows the context menu of the clicked entry.
+     * @param event The mouse event.
+     */
+    void OnRightUp(wxMouseEvent &event);
+
+    FilesTree *m_owner = nullptr;     ///< Tree receiving the user interactions
+    std::vector<FilesTreeNode> m_nodes; ///< Flat node storage
+    std::vector<int> m_freeNodes;     ///< Released node slots available for reuse
+    std::vector<int> m_rows;          ///< Visible node indices in display order, ~node for a "loading" placeholder of node
+    std::unordered_map<wxString, int> m_pathIndex; ///< Node index keyed by path, kept in sync on insert/rename/remove
+    int m_rootNode = -1;              ///< Index of the project root node
+    int m_selectedNode = -1;          ///< Currently highlighted node
+    int m_hoveredNode = -1;           ///< Node under the mouse cursor
+    bool m_rowsDirty = false;         ///< Whether m_rows must be recomputed
+    FilesTreeSortOrder m_sortOrder = FilesTreeSortOrder::Natural; ///< Ordering of the siblings
+    std::shared_ptr<ProjectPathIndex> m_filterIndex; ///< Index of the displayed filter results, null when not filtering
+    std::vector<int> m_filterRows;    ///< Index entries displayed while filtering
+
+    wxColour m_highlightColor; ///< Background of the selected and hovered rows, resolved on every paint
+    wxColour m_borderColor;    ///< Color of the indentation guides, resolved on every paint
+    wxBitmap m_arrowCollapsed; ///< Directory arrow for collapsed folders (shared from the IconsCache)
+    wxBitmap m_arrowExpanded;  ///< Pre-rotated directory arrow for expanded folders
+
+    static constexpr int ROW_HEIGHT = 20;  ///< Height of a tree row in pixels
+    static constexpr int INDENT = 10;      ///< Horizontal offset added per depth level
+    static constexpr int LEFT_MARGIN = 8;  ///< Offset of the first column
+
+    wxDECLARE_NO_COPY_CLASS(FilesTreeView);
+    wxDECLARE_EVENT_TABLE();
+};
@@ -0,0 +1,10 @@
+#include "filesTreeView.hpp"
+
+wxBEGIN_EVENT_TABLE(FilesTreeView, wxVScrolledWindow)
+	EVT_IDLE(FilesTreeView::OnIdle)
+	EVT_PAINT(FilesTreeView::OnPaint)
+	EVT_MOTION(FilesTreeView::OnMouseMotion)
+	EVT_LEAVE_WINDOW(FilesTreeView::OnMouseLeave)
+	EVT_LEFT_UP(FilesTreeView::OnLeftUp)
+	EVT_RIGHT_UP(FilesTreeView::OnRightUp)
+wxEND_EVENT_TABLE()
@@ -1,5 +1,6 @@
 #include "projectInfosTools.hpp"
 #include <appPaths/appPaths.hpp>
+#include <iconsCache/iconsCache.hpp>
 #include <ui/ids.hpp>
 #include <gui/panels/filesTree/filesTree.hpp>
 
@@ -20,19 +21,15 @@ ProjectInfosTools::ProjectInfosTools(wxPanel *parent, wxWindowID ID) : wxPanel(p
 
 void ProjectInfosTools::CreateCollapseButton()
 {
-    wxString arrowPath = ApplicationPaths::GetIconPath("collapse.png");
-    if (!arrowPath.IsEmpty())
+    const wxBitmap &arrowBitmap = IconsCache::Get().GetIcon("collapse.png");
+    if (arrowBitmap.IsOk())
     {
-        wxBitmap arrowBitmap(arrowPath, wxBITMAP_TYPE_PNG);
-        if (arrowBitmap.IsOk())
-        {
-            m_collapse_button = new wxStaticBitmap(
-                this,
-                +GUI::ControlID::ProjectToolsArrow,
-                arrowBitmap);
-            m_sizer->Add(m_collapse_button, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
-            m_collapse_button->Bind(wxEVT_LEFT_UP, &ProjectInfosTools::OnCollapseButtonClick, this);
-        }
+        m_collapse_button = new wxStaticBitmap(
+            this,
+            +GUI::ControlID::ProjectToolsArrow,
+            arrowBitmap);
+        m_sizer->Add(m_collapse_button, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+        m_collapse_button->Bind(wxEVT_LEFT_UP, &ProjectInfosTools::OnCollapseButtonClick, this);
     }
 }
 
@@ -45,20 +42,7 @@ void ProjectInfosTools::OnCollapseButtonClick(wxMouseEvent &event)
     }
 
     if (m_projectFilesContainer && m_filesTree)
-    {
-        m_projectFilesContainer->CallForEachChild(
-            [&, this](wxWindow *child)
-            {
-                if (child->GetLabel().Contains("_dir_container"))
-                {
-                    if (child->GetChildren().empty())
-                        return;
-
-                    if (child->GetChildren()[1]->IsShown())
-                        m_filesTree->ToggleDirVisibility(child->GetName());
-                }
-            });
-    }
+        m_filesTree->CollapseAll();
 }
 
 void ProjectInfosTools::OnHoverEnter(wxMouseEvent &event)
@@ -43,8 +43,8 @@ private:
     /**
      * @brief Handles mouse click events on the collapse button.
      *
-     * Toggles the visibility of directory containers in the associated
-     * FilesTree by iterating over child windows of the project files container.
+     * Collapses every expanded directory of the associated FilesTree
+     * in a single pass over the expanded part of its tree model.
      *
      * @param event Mouse event triggered by a left button click.
      */
@@ -0,0 +1,162 @@
+#include "projectPathIndex.hpp"
+
+#include "platformInfos/platformInfos.hpp"
+
+#include <wx/filename.h>
+#include <algorithm>
+#include <filesystem>
+
+std::shared_ptr<ProjectPathIndex> ProjectPathIndex::Build(const wxString &root, FilesTreeSortOrder order,
+                                                          const VisibilityPredicate &isVisible,
+                                                          const std::function<bool()> &isCancelled)
+{
+    auto index = std::make_shared<ProjectPathIndex>();
+    index->m_root = root;
+    if (!index->m_root.IsEmpty() && index->m_root.Last() != PlatformInfos::OsPathSeparator())
+        index->m_root.Append(PlatformInfos::OsPathSeparator());
+
+    if (!index->AppendDirectory(std::string(), -1, 0, order, isVisible, isCancelled))
+        return nullptr;
+    return index;
+}
+
+bool ProjectPathIndex::AppendDirectory(const std::string &relativeDir, int parent, int depth, FilesTreeSortOrder order,
+                                       const VisibilityPredicate &isVisible, const std::function<bool()> &isCancelled)
+{
+    if (isCancelled())
+        return false;
+
+    struct ListedEntry
+    {
+        std::string name;
+        std::string sortKey;
+        bool isDir;
+        bool isLink;
+    };
+
+    wxString directory = m_root + wxString::FromUTF8(relativeDir);
+    if (PlatformInfos::OsPathSeparator() != '/')
+        directory.Replace("/", wxString(PlatformInfos::OsPathSeparator()));
+
+    std::vector<ListedEntry> listed;
+    std::error_code error;
+    std::filesystem::directory_iterator iterator(std::filesystem::path(directory.ToStdWstring()), error);
+    for (auto end = std::filesystem::directory_iterator(); !error && iterator != end; iterator.increment(error))
+    {
+        const auto &entry = *iterator;
+        std::error_code typeError;
+        bool isDir = entry.is_directory(typeError);
+        bool isLink = entry.is_symlink(typeError);
+
+        wxString entryPath(entry.path().wstring());
+        wxString name = wxFileNameFromPath(entryPath);
+        if (!isVisible(entryPath, name, isDir))
+            continue;
+
+        listed.push_back({name.utf8_string(), FilesTreeView::MakeSortKey(name, order), isDir, isLink});
+    }
+
+    std::sort(listed.begin(), listed.end(), [](const ListedEntry &a, const ListedEntry &b)
+              {
+        if (a.isDir != b.isDir)
+            return a.isDir;
+        return a.sortKey < b.sortKey; });
+
+    for (auto &listedEntry : listed)
+    {
+        ProjectPathEntry entry;
+        entry.relativePath = relativeDir + listedEntry.name;
+        entry.foldedPath = wxString::FromUTF8(entry.relativePath).Lower().utf8_string();
+        entry.nameOffset = (uint32_t)relativeDir.size();
+        entry.parent = parent;
+        entry.depth = depth;
+        entry.isDir = listedEntry.isDir;
+
+        int current = (int)m_entries.size();
+        m_entries.push_back(std::move(entry));
+
+        // Symbolic links to directories are listed but not walked, they may point back into the project
+        if (listedEntry.isDir && !listedEntry.isLink &&
+            !AppendDirectory(m_entries[current].relativePath + '/', current, depth + 1, order, isVisible, isCancelled))
+            return false;
+    }
+    return true;
+}
+
+size_t ProjectPathIndex::Filter(const wxString &query, std::vector<int> &rows)
+{
+    rows.clear();
+
+    std::string folded = wxString(query).Trim(true).Trim(false).Lower().utf8_string();
+    if (PlatformInfos::OsPathSeparator() != '/')
+        std::replace(folded.begin(), folded.end(), (char)PlatformInfos::OsPathSeparator(), '/');
+
+    if (folded.empty())
+    {
+        m_lastQuery.clear();
+        m_lastMatches.clear();
+        return 0;
+    }
+
+    if (m_emitted.size() != m_entries.size() || ++m_generation == 0)
+    {
+        m_emitted.assign(m_entries.size(), 0);
+        m_generation = 1;
+    }
+
+    // A query extending the previous one can only match a subset of the previous matches
+    const bool narrowing = !m_lastQuery.empty() && folded.find(m_lastQuery) != std::string::npos;
+
+    std::vector<int> matches;
+    std::vector<int> ancestors;
+    auto test = [&](int candidate)
+    {
+        const auto &entry = m_entries[candidate];
+        if (entry.isDir || entry.foldedPath.find(folded) == std::string::npos)
+            return;
+
+        matches.push_back(candidate);
+
+        // Entries are in display order, so the ancestors not emitted yet directly precede the file
+        ancestors.clear();
+        for (int parent = entry.parent; parent >= 0 && m_emitted[parent] != m_generation; parent = m_entries[parent].parent)
+        {
+            m_emitted[parent] = m_generation;
+            ancestors.push_back(parent);
+        }
+        rows.insert(rows.end(), ancestors.rbegin(), ancestors.rend());
+        rows.push_back(candidate);
+    };
+
+    if (narrowing)
+    {
+        for (int candidate : m_lastMatches)
+            test(candidate);
+    }
+    else
+    {
+        for (int candidate = 0; candidate < (int)m_entries.size(); ++candidate)
+            test(candidate);
+    }
+
+    m_lastQuery = std::move(folded);
+    m_lastMatches.swap(matches);
+    return m_lastMatches.size();
+}
+
+wxString ProjectPathIndex::GetPath(int entry) const
+{
+    wxString path = m_root + wxString::FromUTF8(m_entries[entry].relativePath);
+    if (PlatformInfos::OsPathSeparator() != '/')
+        path.Replace("/", wxString(PlatformInfos::OsPathSeparator()));
+    if (m_entries[entry].isDir)
+        path.Append(PlatformInfos::OsPathSeparator());
+    return path;
+}
+
+wxString ProjectPathIndex::GetName(int entry) const
+{
+    const auto &target = m_entries[entry];
+    return wxString::FromUTF8(target.relativePath.c_str() + target.nameOffset,
+                              target.relativePath.size() - target.nameOffset);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <wx/string.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gui/panels/filesTree/filesTreeView/filesTreeView.hpp"
+
+/**
+ * @struct ProjectPathEntry
+ * @brief A file or directory of the project, as stored by the ProjectPathIndex.
+ */
+struct ProjectPathEntry
+{
+    std::string relativePath; ///< UTF-8 path relative to the project root, '/' separated
+    std::string foldedPath;   ///< Lower-cased relativePath, matched against the filter
+    uint32_t nameOffset = 0;  ///< Offset of the entry name inside relativePath
+    int parent = -1;          ///< Index of the parent directory entry, -1 for the root children
+    int depth = 0;            ///< Nesting level, the root children have depth 0
+    bool isDir = false;       ///< Whether the entry is a directory
+};
+
+/**
+ * @class ProjectPathIndex
+ * @brief In-memory list of every path of the project, used to filter the file tree.
+ *
+ * Entries are stored in the order the tree displays them (depth-first,
+ * directories first), so the rows of a filter are produced in a single pass
+ * without sorting. A query only scans the lower-cased paths, and a query
+ * extending the previous one only rescans the previous matches.
+ *
+ * The index is built on a worker thread and only used on the UI thread afterwards.
+ */
+class ProjectPathIndex
+{
+public:
+    /**
+     * @brief Tells whether an entry is listed, see FilesTree::IsEntryVisible().
+     */
+    using VisibilityPredicate = std::function<bool(const wxString &path, const wxString &name, bool isDir)>;
+
+    /**
+     * @brief Lists the whole project, blocking until done.
+     * @param root Absolute project path, ending with the path separator.
+     * @param order Ordering of the entries of a directory.
+     * @param isVisible Filters out hidden and ignored entries (skipped directories are not walked).
+     * @param isCancelled Polled between directories, the build stops early when it returns true.
+     * @return The index, or nullptr when the build was cancelled.
+     */
+    static std::shared_ptr<ProjectPathIndex> Build(const wxString &root, FilesTreeSortOrder order,
+                                                   const VisibilityPredicate &isVisible,
+                                                   const std::function<bool()> &isCancelled);
+
+    /**
+     * @brief Computes the rows shown for a query.
+     *
+     * Files whose relative path contains the query (case-insensitive) are
+     * kept together with their ancestor directories, in display order.
+     *
+     * @param query The filter text.
+     * @param rows Receives the entry indices to display, empty when nothing matches.
+     * @return The number of matching files.
+     */
+    size_t Filter(const wxString &query, std::vector<int> &rows);
+
+    /**
+     * @brief Gives access to an entry.
+     * @param entry A valid entry index.
+     */
+    const ProjectPathEntry &GetEntry(int entry) const { return m_entries[entry]; }
+
+    /**
+     * @brief Returns the absolute path of an entry (directories end with the path separator).
+     * @param entry A valid entry index.
+     */
+    wxString GetPath(int entry) const;
+
+    /**
+     * @brief Returns the display name of an entry.
+     * @param entry A valid entry index.
+     */
+    wxString GetName(int entry) const;
+
+    /**
+     * @brief Returns the number of indexed entries.
+     */
+    size_t GetEntryCount() const { return m_entries.size(); }
+
+private:
+    /**
+     * @brief Appends the content of a directory, then recursively the content of its subdirectories.
+     * @return False if the build was cancelled.
+     */
+    bool AppendDirectory(const std::string &relativeDir, int parent, int depth, FilesTreeSortOrder order,
+                         const VisibilityPredicate &isVisible, const std::function<bool()> &isCancelled);
+
+    wxString m_root;                      ///< Project root, ending with the path separator
+    std::vector<ProjectPathEntry> m_entries; ///< Entries in display order
+
+    std::string m_lastQuery;              ///< Lower-cased query of the previous Filter() call
+    std::vector<int> m_lastMatches;       ///< Files matched by the previous query
+    std::vector<uint32_t> m_emitted;      ///< Generation an ancestor was last emitted in
+    uint32_t m_generation = 0;            ///< Incremented on every Filter() call
+};
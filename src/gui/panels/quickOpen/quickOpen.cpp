@@ -3,6 +3,7 @@
 #include <wx/splitter.h>
 #include <projectSettings/projectSettings.hpp>
 #include "gui/panels/filesTree/filesTree.hpp"
+#include "ignoreEngine/ignoreEngine.hpp"
 
 QuickOpen::QuickOpen(wxFrame *parent)
     : wxPanel(parent, +GUI::ControlID::QuickOpen, wxPoint(parent->GetSize().GetWidth() / 2 - 200, 50), wxSize(450, 200))
@@ -95,21 +96,20 @@ void QuickOpen::CreateScrolledContainer()
         const fs::directory_entry &entry = *it;
         const fs::path &path = entry.path();
 
+        wxString fullPath = wxString::FromUTF8(path.string());
+
         if (entry.is_directory())
         {
-            std::string dirName = path.filename().string();
-
-            if (kIgnoredDirs.contains(dirName))
+            if (IgnoreEngine::Get().IsIgnored(fullPath, true, IgnoreScope::Search))
             {
                 it.disable_recursion_pending();
             }
             continue;
         }
 
-        if (!entry.is_regular_file())
+        if (!entry.is_regular_file() || IgnoreEngine::Get().IsIgnored(fullPath, false, IgnoreScope::Search))
             continue;
 
-        wxString fullPath = wxString::FromUTF8(path.string());
         wxString fileName = wxString::FromUTF8(path.filename().string());
 
         if (i == 0)
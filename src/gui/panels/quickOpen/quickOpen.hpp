@@ -2,7 +2,6 @@
 
 #include <wx/wx.h>
 #include <wx/scrolwin.h>
-#include <unordered_set>
 
 #include "ui/ids.hpp"
 #include "themesManager/themesManager.hpp"
@@ -26,29 +25,6 @@ struct QuickOpenFileStruct
     wxPanel *panel;
 };
 
-/**
- * @brief Set of directory names ignored during project file indexing.
- *
- * These directories are skipped entirely during recursive filesystem traversal
- * in order to avoid unnecessary IO, improve performance, and prevent indexing
- * of generated or external dependency files.
- *
- * This list mirrors common editor exclusions (e.g. VS Code).
- */
-static const std::unordered_set<std::string> kIgnoredDirs = {
-    ".git",
-    ".svn",
-    ".hg",
-    "build",
-    "dist",
-    "out",
-    "node_modules",
-    ".vscode",
-    ".idea",
-    "__pycache__",
-    "cmake-build-debug",
-    "cmake-build-release"};
-
 /**
  * @class QuickOpen
  * @brief Keyboard-driven file navigation panel (Ctrl+P).
@@ -8,6 +8,7 @@
 #include <projectSettings/projectSettings.hpp>
 #include <gui/panels/filesTree/filesTree.hpp>
 #include <themesManager/themesManager.hpp>
+#include <ignoreEngine/ignoreEngine.hpp>
 
 SearchPage::SearchPage(wxWindow* parent)
     : wxPanel(parent, +GUI::ControlID::SearchPage)
@@ -92,21 +93,13 @@ void SearchPage::SetWorkspaceRoot(const wxString& path)
     m_workspaceRoot = path;
 }
 
-bool SearchPage::ShouldIgnoreDirectory(const wxString& name) const
+bool SearchPage::ShouldIgnore(const wxString& path, bool isDir) const
 {
-    if (name.StartsWith("."))
+    // Dot-directories (.git, .idea, .venv, .gradle...) hold tool data, never project sources
+    if (isDir && wxFileNameFromPath(path).StartsWith("."))
         return true;
 
-    static const std::set<wxString> ignored = {
-        "node_modules",
-        "build",
-        "dist",
-        "out",
-        ".cache",
-        ".next"
-    };
-
-    return ignored.contains(name);
+    return IgnoreEngine::Get().IsIgnored(path, isDir, IgnoreScope::Search);
 }
 
 void SearchPage::PerformSearch()
@@ -136,11 +129,14 @@ void SearchPage::SearchDirectory(const wxString& path)
 
         if (wxDirExists(fn.GetFullPath()))
         {
-            if (!ShouldIgnoreDirectory(name))
+            if (!ShouldIgnore(fn.GetFullPath(), true))
                 SearchDirectory(fn.GetFullPath());
             continue;
         }
 
+        if (ShouldIgnore(fn.GetFullPath(), false))
+            continue;
+
         wxTextFile file(fn.GetFullPath());
         if (!file.Open())
             continue;
@@ -49,15 +49,17 @@ private:
     void SearchDirectory(const wxString& path);
 
     /**
-     * @brief Determines whether a directory should be ignored during search.
+     * @brief Determines whether an entry should be ignored during search.
      *
-     * Typically used to skip large or irrelevant folders
-     * (e.g. node_modules, .git).
+     * Directories whose name starts with '.' are always skipped, other entries
+     * are checked by the IgnoreEngine, so .gitignore/.ignore files and the
+     * files/exclude and search/exclude lists are honoured (e.g. node_modules).
      *
-     * @param name Directory name.
-     * @return true if the directory should be ignored.
+     * @param path Absolute path of the entry.
+     * @param isDir Whether the entry is a directory.
+     * @return true if the entry should be ignored.
      */
-    bool ShouldIgnoreDirectory(const wxString& name) const;
+    bool ShouldIgnore(const wxString& path, bool isDir) const;
 
     /**
      * @brief Triggered when the search button is clicked.
@@ -0,0 +1,36 @@
+#include "tabIcon.hpp"
+
+TabIcon::TabIcon(wxWindow *parent, const wxBitmap &closeIcon, const wxBitmap &unsavedIcon)
+    : wxStaticBitmap(parent, wxID_ANY, closeIcon), m_closeIcon(closeIcon), m_unsavedIcon(unsavedIcon)
+{
+    SetName("tab_icon_close_or_unsaved");
+}
+
+void TabIcon::SetModified(bool modified)
+{
+    if (m_modified == modified)
+        return;
+
+    m_modified = modified;
+    UpdateBitmap();
+}
+
+void TabIcon::SetHovered(bool hovered)
+{
+    if (m_hovered == hovered)
+        return;
+
+    m_hovered = hovered;
+    UpdateBitmap();
+}
+
+void TabIcon::UpdateBitmap()
+{
+    const bool showUnsaved = m_modified && !m_hovered && m_unsavedIcon.IsOk();
+    if (showUnsaved == m_showsUnsaved)
+        return;
+
+    m_showsUnsaved = showUnsaved;
+    SetBitmap(showUnsaved ? m_unsavedIcon : m_closeIcon);
+    GetParent()->Layout();
+}
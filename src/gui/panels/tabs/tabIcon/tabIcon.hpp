@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file tabIcon.hpp
+ * @brief Declaration of the TabIcon class, the close/unsaved button of a tab.
+ */
+
+#include <wx/bitmap.h>
+#include <wx/statbmp.h>
+
+/**
+ * @class TabIcon
+ * @brief Close button of a tab, replaced by an unsaved marker while its document is modified.
+ *
+ * The icon remembers whether its document is modified and whether the mouse
+ * is over the tab, and only swaps its bitmap when the shown icon changes.
+ * Both bitmaps are handed over by the Tabs panel when the icon is created, so
+ * notifying every modification of an already modified document is free.
+ *
+ * ### Example:
+ * @code
+ * auto icon = new TabIcon(tabInfos, closeIcon, unsavedIcon);
+ * editor->SetTabIcon(icon);
+ * icon->SetModified(true); // shows the unsaved marker
+ * @endcode
+ */
+class TabIcon : public wxStaticBitmap
+{
+public:
+    /**
+     * @brief Constructs the icon, showing the close bitmap.
+     * @param parent The tab informations panel.
+     * @param closeIcon Bitmap shown when the document is saved or the tab hovered.
+     * @param unsavedIcon Bitmap shown when the document is modified.
+     */
+    TabIcon(wxWindow *parent, const wxBitmap &closeIcon, const wxBitmap &unsavedIcon);
+
+    /**
+     * @brief Tells the icon whether its document has unsaved changes.
+     */
+    void SetModified(bool modified);
+
+    /**
+     * @brief Tells the icon whether the mouse is over its tab, which always shows the close bitmap.
+     */
+    void SetHovered(bool hovered);
+
+    /**
+     * @brief Tells whether the unsaved marker is shown.
+     */
+    bool ShowsUnsaved() const { return m_showsUnsaved; }
+
+private:
+    /**
+     * @brief Swaps the bitmap if the icon to show changed.
+     */
+    void UpdateBitmap();
+
+    wxBitmap m_closeIcon;        ///< Shown when saved or hovered
+    wxBitmap m_unsavedIcon;      ///< Shown when modified and not hovered
+    bool m_modified = false;     ///< Whether the document has unsaved changes
+    bool m_hovered = false;      ///< Whether the mouse is over the tab
+    bool m_showsUnsaved = false; ///< Whether the current bitmap is the unsaved marker
+
+    wxDECLARE_NO_COPY_CLASS(TabIcon);
+};
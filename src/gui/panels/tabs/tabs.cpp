@@ -6,6 +6,7 @@
 #include "gui/widgets/saveChangesDialog/saveChangesDialog.hpp"
 #include "menus/tabsContainerMenu.hpp"
 #include "errorMessages/errorMessages.hpp"
+#include "iconsCache/iconsCache.hpp"
 
 #include <wx/graphics.h>
 #include <fileOperations/fileOperations.hpp>
@@ -25,6 +26,9 @@ Tabs::Tabs(wxPanel *parent, wxWindowID ID) : wxPanel(parent, ID)
     menu = new wxStaticBitmap(this, wxID_ANY, wxBitmapBundle::FromBitmaps(bitmaps));
     menu->Bind(wxEVT_LEFT_UP, &Tabs::OnMenu, this);
 
+    closeIcon = IconsCache::Get().GetIcon("close.png");
+    unsavedIcon = IconsCache::Get().GetIcon(wxString("unsaved") + (ThemesManager::Get().IsDarkTheme() ? "_light" : "_dark") + ".png");
+
     sizer->Add(tabsContainer, 1, wxEXPAND | wxTOP | wxBOTTOM, 5);
     sizer->Add(menu, 0, wxALIGN_CENTER | wxRIGHT, 10);
 
@@ -44,6 +48,8 @@ void Tabs::Add(wxString tab_name, wxString path)
         Show();
 
     bool exists = false;
+    if (projectSettings.GetCurrentlyFileOpen() != path)
+        SaveEditorState(projectSettings.GetCurrentlyFileOpen());
     projectSettings.SetCurrentlyFileOpen(path);
     for (auto &a_tab : tabsContainer->GetChildren())
     {
@@ -62,26 +68,14 @@ void Tabs::Add(wxString tab_name, wxString path)
 
     new_tab->SetName(path);
     new_tab->SetLabel(path + "_tab");
+    tabsByPath[path] = new_tab;
     new_tab->Bind(wxEVT_LEFT_UP, &Tabs::OnTabClick, this);
     wxBoxSizer *new_tab_sizer = new wxBoxSizer(wxVERTICAL);
 
     wxPanel *tab_infos = new wxPanel(new_tab);
     wxBoxSizer *tab_infos_sizer = new wxBoxSizer(wxHORIZONTAL);
 
-    wxString iconPath;
-
-    if (FileOperations::IsImageFile(path))
-    {
-        iconPath = ApplicationPaths::GetLanguageIcon("image");
-    }
-    else
-    {
-        iconPath = LanguagesPreferences::Get().GetLanguageIconPath(path);
-    }
-
-    wxVector<wxBitmap> bitmaps_;
-    bitmaps_.push_back(wxBitmap(iconPath, wxBITMAP_TYPE_PNG));
-    wxStaticBitmap *ico = new wxStaticBitmap(tab_infos, wxID_ANY, wxBitmapBundle::FromBitmaps(bitmaps_));
+    wxStaticBitmap *ico = new wxStaticBitmap(tab_infos, wxID_ANY, IconsCache::Get().GetFileIcon(path));
     ico->SetName("tab_language_icon");
     tab_infos_sizer->Add(ico, 0, wxALIGN_CENTER | wxLEFT, 10);
 
@@ -91,10 +85,7 @@ void Tabs::Add(wxString tab_name, wxString path)
     name->Bind(wxEVT_LEFT_UP, &Tabs::OnTabClick, this);
     tab_infos_sizer->Add(name, 1, wxEXPAND | wxLEFT | wxRIGHT, 6);
 
-    wxVector<wxBitmap> bitmaps;
-    bitmaps.push_back(wxBitmap(wxBitmap(iconsDir + "close.png", wxBITMAP_TYPE_PNG)));
-    wxStaticBitmap *close_icon = new wxStaticBitmap(tab_infos, wxID_ANY, wxBitmapBundle::FromBitmaps(bitmaps));
-    close_icon->SetName("tab_icon_close_or_unsaved");
+    TabIcon *close_icon = new TabIcon(tab_infos, closeIcon, unsavedIcon);
     close_icon->Bind(wxEVT_LEFT_UP, &Tabs::OnCloseTab, this);
     tab_infos_sizer->Add(close_icon, 0, wxALIGN_CENTER | wxRIGHT, 10);
 
@@ -132,6 +123,7 @@ void Tabs::Close(wxWindow *tab, wxString tab_path)
 
     if (codeContainer)
     {
+        codeContainer->editor->FlushAutoSave();
         if (codeContainer->editor->Modified())
         {
             SaveChangesDialog dlg(NULL, wxString::Format(_("Do you want to save the changes you made to: %s?"), wxFileNameFromPath(codeContainer->currentPath)), "Krafta Editor");
@@ -149,6 +141,7 @@ void Tabs::Close(wxWindow *tab, wxString tab_path)
                 return;
             }
         }
+        Editor::SaveStates({codeContainer->editor});
         codeContainer->Destroy();
     }
     if (imgContainer)
@@ -169,11 +162,7 @@ void Tabs::Close(wxWindow *tab, wxString tab_path)
         projectSettings.SetCurrentlyFileOpen(descendantTab->GetName());
         descendantTab->Refresh();
 
-        auto linkedFile = FindWindowByLabel(ProjectSettings::Get().GetCurrentlyFileOpen() + "_file_container");
-        if (linkedFile)
-        {
-            fileContainer->SetFileHighlight(linkedFile->GetName());
-        }
+        fileContainer->SetFileHighlight(ProjectSettings::Get().GetCurrentlyFileOpen());
 
         auto other_codeContainer = ((CodeContainer *)FindWindowByName(ProjectSettings::Get().GetCurrentlyFileOpen() + "_codeContainer"));
         if (other_codeContainer)
@@ -201,6 +190,10 @@ void Tabs::Close(wxWindow *tab, wxString tab_path)
         }
     }
 
+    auto indexed = tabsByPath.find(tab_path);
+    if (indexed != tabsByPath.end() && indexed->second == tab)
+        tabsByPath.erase(indexed);
+
     tab->Destroy();
     tabsContainer->GetSizer()->Layout();
     tabsContainer->FitInside();
@@ -219,12 +212,22 @@ void Tabs::CloseAllFiles()
             mainCodeChildren->Hide();
     }
 
+    std::vector<Editor *> editors;
     for (auto &&child : childrenToRemove)
     {
-        child->Destroy();
+        if (auto codeContainer = dynamic_cast<CodeContainer *>(child))
+        {
+            codeContainer->editor->FlushAutoSave();
+            editors.push_back(codeContainer->editor);
+        }
     }
+    Editor::SaveStates(editors);
+
+    for (auto &&child : childrenToRemove)
+        child->Destroy();
 
     tabsContainer->DestroyChildren();
+    tabsByPath.clear();
     Hide();
 
     if (auto emptyWindow = FindWindowById(+GUI::ControlID::EmptyWindow))
@@ -271,6 +274,98 @@ void Tabs::Select()
     mainCode->Update();
 }
 
+void Tabs::SetLoadingProgress(const wxString &path, int percent)
+{
+    auto tab = FindTab(path);
+    if (!tab || tab->GetChildren().empty())
+        return;
+
+    auto name = ((wxStaticText *)tab->GetChildren()[0]->GetChildren()[1]);
+    if (!name)
+        return;
+
+    wxString label = wxFileNameFromPath(path);
+    if (percent >= 0)
+        label += wxString::Format(" (%d%%)", percent);
+
+    if (name->GetLabel() == label)
+        return;
+
+    name->SetLabel(label);
+    tab->GetChildren()[0]->Layout();
+    tab->Layout();
+    tabsContainer->FitInside();
+}
+
+void Tabs::AttachDocument(const wxString &path, Editor *editor)
+{
+    auto tab = FindTab(path);
+    if (!tab || tab->GetChildren().empty() || !editor)
+        return;
+
+    auto icon = GetTabIcon(tab->GetChildren()[0]);
+    if (!icon)
+        return;
+
+    editor->SetTabIcon(icon);
+    icon->SetModified(editor->Modified());
+}
+
+void Tabs::SaveEditorState(const wxString &path)
+{
+    if (path.IsEmpty())
+        return;
+
+    if (auto codeContainer = ((CodeContainer *)FindWindowByName(path + "_codeContainer")))
+        Editor::SaveStates({codeContainer->editor});
+}
+
+wxWindow *Tabs::FindTab(const wxString &path) const
+{
+    auto tab = tabsByPath.find(path);
+    return tab != tabsByPath.end() ? tab->second : nullptr;
+}
+
+void Tabs::Rename(const wxString &oldPath, const wxString &newPath)
+{
+    auto indexed = tabsByPath.find(oldPath);
+    if (indexed == tabsByPath.end())
+        return;
+
+    wxWindow *tab = indexed->second;
+    tabsByPath.erase(indexed);
+    tabsByPath[newPath] = tab;
+
+    tab->SetName(newPath);
+    tab->SetLabel(newPath + "_tab");
+    tab->SetToolTip(newPath);
+
+    auto tabInfos = tab->GetChildren()[0];
+    auto tabText = ((wxStaticText *)tabInfos->GetChildren()[1]);
+    if (tabText)
+    {
+        tabText->SetName(newPath);
+        tabText->SetLabel(wxFileNameFromPath(newPath));
+    }
+
+    auto tabIcon = ((wxStaticBitmap *)tabInfos->GetChildren()[0]);
+    if (tabIcon)
+    {
+        const wxBitmap &tabIconBitmap = IconsCache::Get().GetFileIcon(newPath);
+        if (tabIconBitmap.IsOk())
+            tabIcon->SetBitmap(tabIconBitmap);
+    }
+
+    tabInfos->Layout();
+}
+
+TabIcon *Tabs::GetTabIcon(wxWindow *tabInfos)
+{
+    if (!tabInfos || tabInfos->GetChildren().size() < 3)
+        return nullptr;
+    return dynamic_cast<TabIcon *>(tabInfos->GetChildren()[2]);
+}
+
 void Tabs::OnTabClick(wxMouseEvent &event)
 {
     auto target = ((wxWindow *)event.GetEventObject());
@@ -281,6 +376,7 @@ void Tabs::OnTabClick(wxMouseEvent &event)
     if (path == ProjectSettings::Get().GetCurrentlyFileOpen())
         return;
 
+    SaveEditorState(ProjectSettings::Get().GetCurrentlyFileOpen());
     ProjectSettings::Get().SetCurrentlyFileOpen(path);
     Select();
 }
@@ -310,68 +406,14 @@ void Tabs::OnMenu(wxMouseEvent &WXUNUSED(event))
 
 void Tabs::OnEnterComp(wxMouseEvent &event)
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (target)
-    {
-        auto editor = ((wxStyledTextCtrl *)FindWindowByName(target->GetParent()->GetName() + "_codeEditor"));
-        if (!editor)
-            return;
-
-        auto icon = ((wxStaticBitmap *)target->GetChildren()[2]);
-        if (!icon)
-            return;
-
-        if (icon->GetLabel() == "saved_icon")
-            return;
-
-        auto closeIcon = wxBitmap(iconsDir + "close.png", wxBITMAP_TYPE_PNG);
-        if (!closeIcon.IsOk())
-            return;
-
-        icon->SetBitmap(closeIcon);
-        icon->SetLabel("saved_icon");
-
-        Layout();
-    }
+    if (auto icon = GetTabIcon((wxWindow *)event.GetEventObject()))
+        icon->SetHovered(true);
 }
 
 void Tabs::OnLeaveComp(wxMouseEvent &event)
 {
-    auto target = ((wxWindow *)event.GetEventObject());
-    if (target)
-    {
-        auto editor = ((wxStyledTextCtrl *)FindWindowByName(target->GetParent()->GetName() + "_codeEditor"));
-        if (!editor)
-            return;
-
-        auto icon = ((wxStaticBitmap *)target->GetChildren()[2]);
-        if (!icon)
-            return;
-
-        if (editor->GetModify())
-        {
-            if (icon->GetLabel() == "unsaved_icon")
-                return;
-
-            auto unsavedIcon = wxBitmap(iconsDir + "unsaved_light.png", wxBITMAP_TYPE_PNG);
-            if (!unsavedIcon.IsOk())
-                return;
-            icon->SetBitmap(unsavedIcon);
-            icon->SetLabel("unsaved_icon");
-        }
-        else
-        {
-            if (icon->GetLabel() == "saved_icon")
-                return;
-
-            auto closeIcon = wxBitmap(iconsDir + "close.png", wxBITMAP_TYPE_PNG);
-            if (!closeIcon.IsOk())
-                return;
-            icon->SetBitmap(closeIcon);
-            icon->SetLabel("saved_icon");
-        }
-        Layout();
-    }
+    if (auto icon = GetTabIcon((wxWindow *)event.GetEventObject()))
+        icon->SetHovered(false);
 }
 
 void Tabs::OnPaint(wxPaintEvent &WXUNUSED(event))
@@ -416,6 +458,7 @@ void Tabs::OnPreviousTab()
             auto prevTab = tab->GetPrevSibling();
             if (prevTab)
             {
+                SaveEditorState(tab->GetName());
                 ProjectSettings::Get().GetCurrentlyFileOpen() = prevTab->GetName();
                 Select();
             }
@@ -430,6 +473,7 @@ void Tabs::OnNextTab()
             auto nextTab = tab->GetNextSibling();
             if (nextTab)
             {
+                SaveEditorState(tab->GetName());
                 projectSettings.SetCurrentlyFileOpen(nextTab->GetName());
                 Select();
             }
@@ -10,6 +10,7 @@
 #include "appConstants/appConstants.hpp"
 #include "projectSettings/projectSettings.hpp"
 #include "gui/widgets/statusBar/statusBar.hpp"
+#include "tabIcon/tabIcon.hpp"
 #include "ui/ids.hpp"
 
 #include <nlohmann/json.hpp>
@@ -17,6 +18,9 @@ using json = nlohmann::json;
 
 #include <wx/wx.h>
 #include <wx/scrolwin.h>
+#include <unordered_map>
+
+class Editor;
 
 /**
  * @class Tabs
@@ -58,6 +62,34 @@ public:
      */
     void Select();
 
+    /**
+     * @brief Shows the loading progress of a file next to its tab name.
+     * @param path The full path of the file.
+     * @param percent Progress between 0 and 100, or -1 to restore the plain name.
+     */
+    void SetLoadingProgress(const wxString &path, int percent);
+
+    /**
+     * @brief Links the tab of a file to its editor, which then updates the tab icon directly.
+     * @param path The full path of the file.
+     * @param editor The editor showing the file.
+     */
+    void AttachDocument(const wxString &path, Editor *editor);
+
+    /**
+     * @brief Returns the tab of a file without searching the window hierarchy.
+     * @param path The full path of the file.
+     * @return The tab panel, or nullptr if the file is not open.
+     */
+    wxWindow *FindTab(const wxString &path) const;
+
+    /**
+     * @brief Moves the tab of a renamed file to its new path (name, tooltip and icon).
+     * @param oldPath The previous path of the file.
+     * @param newPath The new path of the file.
+     */
+    void Rename(const wxString &oldPath, const wxString &newPath);
+
     /**
      * @brief Handles mouse click event on a tab to select it.
      * @param event The mouse event.
@@ -92,6 +124,18 @@ private:
      */
     void OnLeaveComp(wxMouseEvent &event);
 
+    /**
+     * @brief Returns the close/unsaved icon of a tab.
+     * @param tabInfos The panel holding the icon, name and close button of the tab.
+     */
+    static TabIcon *GetTabIcon(wxWindow *tabInfos);
+
+    /**
+     * @brief Saves the caret, scroll and fold state of the editor of a file before it is hidden.
+     * @param path The full path of the file, nothing is saved if it has no editor.
+     */
+    void SaveEditorState(const wxString &path);
+
     /**
      * @brief Handles paint event for the main Tabs panel.
      * @param WXUNUSED(event) The paint event.
@@ -119,6 +163,9 @@ private:
     wxBoxSizer *tabsContainerSizer;                                                   /**< Sizer for the tabs inside tabsContainer. */
     json Theme = ThemesManager::Get().currentTheme;                                   /**< Cached theme settings. */
     wxString iconsDir = ApplicationPaths::AssetsPath("icons");                        /**< Path to the icons directory. */
+    std::unordered_map<wxString, wxWindow *> tabsByPath;                              /**< Tab panels keyed by file path. */
+    wxBitmap closeIcon;                                                               /**< Close button bitmap shared by the tabs. */
+    wxBitmap unsavedIcon;                                                             /**< Unsaved marker bitmap shared by the tabs. */
     ProjectSettings &projectSettings = ProjectSettings::Get();                        /**< Reference to global project settings. */
     StatusBar *statusBar = ((StatusBar *)FindWindowById(+GUI::ControlID::StatusBar)); /**< Pointer to the global status bar. */
 
@@ -1,6 +1,7 @@
 #include "statusBar.hpp"
 #include "format/format.hpp"
 #include "ui/ids.hpp"
+#include "gui/codeContainer/editor/editor.hpp"
 
 #include <wx/file.h>
 #include <wx/filename.h>
@@ -15,6 +16,19 @@ StatusBar::StatusBar(wxWindow *parent)
 
 	sizer->AddStretchSpacer();
 
+	// large-file mode badge
+	largeFileBadge = new wxStaticText(this, wxID_ANY, _("Large File"));
+	largeFileBadge->SetForegroundColour(ThemesManager::Get().GetColor("secondaryText"));
+	largeFileBadge->SetToolTip(_("Syntax highlighting, minimap, folding, occurrence highlighting and auto save are disabled for this file"));
+	largeFileBadge->Hide();
+	sizer->Add(largeFileBadge, 0, wxALIGN_CENTER | wxRIGHT, 10);
+
+	// autosave failure notice
+	autoSaveError = new wxStaticText(this, wxID_ANY, _("Auto Save Failed"));
+	autoSaveError->SetForegroundColour(ThemesManager::Get().GetColor("secondaryText"));
+	autoSaveError->Hide();
+	sizer->Add(autoSaveError, 0, wxALIGN_CENTER | wxRIGHT, 10);
+
 	// code locale
 	codeLocale = new wxStaticText(this, +GUI::ControlID::StatusBarCodeLocale, "");
 	sizer->Add(codeLocale, 0, wxALIGN_CENTER | wxRIGHT, 10);
@@ -29,6 +43,7 @@ StatusBar::StatusBar(wxWindow *parent)
 
 	SetSizerAndFit(sizer);
 	Bind(wxEVT_PAINT, &StatusBar::OnPaint, this);
+	Bind(wxEVT_IDLE, &StatusBar::OnIdle, this);
 	SetMinSize(wxSize(GetSize().x, 20));
 }
 
@@ -52,6 +67,10 @@ void StatusBar::UpdateComponents(const wxString &path)
 
 	if (FileOperations::IsImageFile(path))
 	{
+		// The locale labels now show the image infos
+		pendingLocaleEditor = nullptr;
+		shownLine = shownColumn = shownTabWidth = -1;
+
 		wxImage *image = new wxImage(path);
 
 		codeLocale->SetLabel(std::to_string(image->GetHeight()) + "x" + std::to_string(image->GetWidth()) + " pixels");
@@ -68,6 +87,11 @@ void StatusBar::UpdateComponents(const wxString &path)
 		fileExt->SetLabel(languageName);
 	}
 
+	auto editor = dynamic_cast<Editor *>(wxWindow::FindWindowByLabel(path + "_codeEditor"));
+	UpdateLargeFileBadge(editor && editor->IsLargeFileMode());
+	if (editor)
+		UpdateCodeLocale(editor);
+
 	if (!IsShown() && UserSettingsManager::Get().GetSetting<bool>("view/showStatusBar").value)
 	{
 		Show();
@@ -80,21 +104,53 @@ void StatusBar::UpdateComponents(const wxString &path)
 
 void StatusBar::UpdateCodeLocale(wxStyledTextCtrl *codeEditor)
 {
+	pendingLocaleEditor = codeEditor;
+}
+
+void StatusBar::OnIdle(wxIdleEvent &event)
+{
+	event.Skip();
+
+	wxStyledTextCtrl *codeEditor = pendingLocaleEditor;
+	pendingLocaleEditor = nullptr;
+	if (!codeEditor)
+		return;
+
 	if (!IsShown() && UserSettingsManager::Get().GetSetting<bool>("view/showStatusBar").value)
 	{
 		Show();
 		GetParent()->GetSizer()->Layout();
 	}
 
-	if (tabSize)
-		tabSize->SetLabel(wxString::Format(_("Tab Size: %S"), std::to_string(codeEditor->GetTabWidth())));
+	const int line = codeEditor->GetCurrentLine() + 1;
+	const int column = codeEditor->GetColumn(codeEditor->GetCurrentPos());
+	const int tabWidth = codeEditor->GetTabWidth();
+
+	const int widthBefore = codeLocale->GetBestSize().x + tabSize->GetBestSize().x;
+
+	bool changed = false;
+	if (tabSize && tabWidth != shownTabWidth)
+	{
+		tabSize->SetLabel(wxString::Format(_("Tab Size: %d"), tabWidth));
+		shownTabWidth = tabWidth;
+		changed = true;
+	}
 
-	if (codeLocale)
-		codeLocale->SetLabel(
-			wxString::Format(_("Line: %S, Column: %S"), std::to_string(codeEditor->GetCurrentLine() + 1), std::to_string(codeEditor->GetColumn(codeEditor->GetCurrentPos()))));
+	if (codeLocale && (line != shownLine || column != shownColumn))
+	{
+		codeLocale->SetLabel(wxString::Format(_("Line: %d, Column: %d"), line, column));
+		shownLine = line;
+		shownColumn = column;
+		changed = true;
+	}
+
+	if (!changed)
+		return;
 
+	// Labels keeping their width keep their place, the sizer only runs when one grew or shrank
+	if (codeLocale->GetBestSize().x + tabSize->GetBestSize().x != widthBefore)
+		sizer->Layout();
 	Refresh();
-	sizer->Layout();
 }
 
 void StatusBar::ClearLabels()
@@ -105,6 +161,9 @@ void StatusBar::ClearLabels()
 	codeLocale->SetLabel("");
 	tabSize->SetLabel("");
 	fileExt->SetLabel("");
+	largeFileBadge->Hide();
+	pendingLocaleEditor = nullptr;
+	shownLine = shownColumn = shownTabWidth = -1;
 
 	Refresh();
 	sizer->Layout();
@@ -120,9 +179,37 @@ void StatusBar::OnPaint(wxPaintEvent &WXUNUSED(event))
 	dc.DrawLine(0, 0, GetSize().GetWidth(), 0);
 }
 
+void StatusBar::UpdateLargeFileBadge(bool largeFile)
+{
+	if (largeFileBadge->IsShown() == largeFile)
+		return;
+
+	largeFileBadge->Show(largeFile);
+	sizer->Layout();
+}
+
+void StatusBar::UpdateAutoSaveError(const wxString &path, bool failed)
+{
+	if (!failed && path != autoSaveErrorPath)
+		return;
+
+	autoSaveErrorPath = failed ? path : wxString();
+	autoSaveError->SetToolTip(failed ? wxString::Format(_("%s could not be written, the changes are kept in the editor"), path) : wxString());
+
+	if (autoSaveError->IsShown() == failed)
+		return;
+
+	autoSaveError->Show(failed);
+	sizer->Layout();
+}
+
 void StatusBar::UpdateLanguage(const languagePreferencesStruct &language)
 {
-	fileExt->SetLabel(wxString(language.preferences["name"].template get<std::string>()));
+	const wxString name(language.preferences["name"].template get<std::string>());
+	if (fileExt->GetLabel() == name)
+		return;
+
+	fileExt->SetLabel(name);
 	Refresh();
 	sizer->Layout();
 }
\ No newline at end of file
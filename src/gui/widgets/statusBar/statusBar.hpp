@@ -15,6 +15,7 @@ using json = nlohmann::json;
 
 #include <wx/wx.h>
 #include <wx/stc/stc.h>
+#include <wx/weakref.h>
 
 /**
  * @class StatusBar
@@ -37,7 +38,11 @@ public:
     void UpdateComponents(const wxString& path);
 
     /**
-     * @brief Updates the cursor position and locale information (Line, Column).
+     * @brief Requests an update of the cursor position and locale information (Line, Column).
+     *
+     * The labels are refreshed on the next idle event, so a burst of key
+     * repeats or modifications costs a single update.
+     *
      * @param codeEditor A pointer to the active wxStyledTextCtrl.
      */
     void UpdateCodeLocale(wxStyledTextCtrl* codeEditor);
@@ -59,12 +64,37 @@ public:
      */
     void UpdateLanguage(const languagePreferencesStruct& language);
 
+    /**
+     * @brief Shows or hides the badge telling the current file is opened in large-file mode.
+     * @param largeFile Whether the current editor runs in large-file mode.
+     */
+    void UpdateLargeFileBadge(bool largeFile);
+
+    /**
+     * @brief Shows or hides the notice telling the last autosave of a file failed.
+     * @param path The file the autosave was for.
+     * @param failed Whether the write failed; a successful save of the same file hides the notice.
+     */
+    void UpdateAutoSaveError(const wxString& path, bool failed);
+
 public:
     wxStaticText* codeLocale = nullptr; /**< Displays line and column number (e.g., Ln 10, Col 5). */
     wxStaticText* tabSize = nullptr; /**< Displays tab size and/or indentation type. */
     wxStaticText* fileExt = nullptr; /**< Displays the file extension or programming language name. */
+    wxStaticText* largeFileBadge = nullptr; /**< Shown while the current file is opened in large-file mode. */
+    wxStaticText* autoSaveError = nullptr; /**< Shown after an autosave failed, instead of a dialog. */
 
 private:
+    /**
+     * @brief Applies the pending code locale update, touching only the labels whose value changed.
+     */
+    void OnIdle(wxIdleEvent& event);
+
+    wxWeakRef<wxStyledTextCtrl> pendingLocaleEditor; /**< Editor whose locale is shown at the next idle event. */
+    int shownLine = -1; /**< Line currently displayed by codeLocale, -1 when empty. */
+    int shownColumn = -1; /**< Column currently displayed by codeLocale. */
+    int shownTabWidth = -1; /**< Tab width currently displayed by tabSize, -1 when empty. */
+    wxString autoSaveErrorPath; /**< File the autoSaveError notice is about. */
     wxBoxSizer* sizer = new wxBoxSizer(wxHORIZONTAL); /**< Main sizer for the status bar layout. */
     wxDECLARE_NO_COPY_CLASS(StatusBar);
 };
\ No newline at end of file
@@ -3,14 +3,119 @@
 #include <wx/filename.h>
 #include <wx/string.h>
 #include <wx/log.h>
+#include <wx/utils.h>
 #include <filesystem>
 #include <string>
 #include <exception>
 #include <system_error>
 #include <unordered_set>
+#include <algorithm>
+#include <atomic>
+
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
+namespace
+{
+    /**
+     * @brief Creates a file, writes the whole buffer and flushes it to the disk.
+     * @param temp The file to create, it must not exist.
+     * @param original The file being replaced, its owner, group and permissions are copied if it exists (POSIX).
+     */
+    bool WriteSyncedFile(const fs::path &temp, const fs::path &original, const char *data, size_t size)
+    {
+#ifdef __WXMSW__
+        (void)original; // ReplaceFileW() carries the attributes and ACLs over, see MoveOverFile()
+        HANDLE file = ::CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        bool ok = true;
+        while (ok && size > 0)
+        {
+            DWORD chunk = (DWORD)std::min<size_t>(size, 1u << 30);
+            DWORD written = 0;
+            ok = ::WriteFile(file, data, chunk, &written, nullptr) && written > 0;
+            data += written;
+            size -= written;
+        }
+
+        ok = ok && ::FlushFileBuffers(file);
+        return ::CloseHandle(file) && ok;
+#else
+        struct stat status;
+        const bool exists = ::stat(original.c_str(), &status) == 0;
+        const mode_t mode = exists ? (status.st_mode & 07777) : 0666;
+
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+        if (fd < 0)
+            return false;
+
+        bool ok = true;
+        while (ok && size > 0)
+        {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0 && errno == EINTR)
+                continue;
+            ok = written > 0;
+            if (ok)
+            {
+                data += written;
+                size -= (size_t)written;
+            }
+        }
+
+        // Best effort: only root may give the file away, a group is kept if the user belongs to it.
+        // chown() may clear the set-user-ID bits, so it runs before fchmod()
+        if (ok && exists && (status.st_uid != ::geteuid() || status.st_gid != ::getegid()))
+        {
+            if (::fchown(fd, status.st_uid, status.st_gid) != 0)
+                (void)::fchown(fd, (uid_t)-1, status.st_gid);
+        }
+
+        // The umask applies to open(), the permissions of the replaced file are restored explicitly
+        if (ok && exists)
+            ok = ::fchmod(fd, mode) == 0;
+
+        ok = ok && ::fsync(fd) == 0;
+        return ::close(fd) == 0 && ok;
+#endif
+    }
+
+    /**
+     * @brief Moves the temporary file over the destination, flushing the rename itself to the disk.
+     */
+    bool MoveOverFile(const fs::path &temp, const fs::path &target)
+    {
+#ifdef __WXMSW__
+        // ReplaceFileW() gives the new file the attributes, ACLs and creation time of the replaced one
+        if (::GetFileAttributesW(target.c_str()) != INVALID_FILE_ATTRIBUTES &&
+            ::ReplaceFileW(target.c_str(), temp.c_str(), nullptr, REPLACEFILE_IGNORE_MERGE_ERRORS, nullptr, nullptr))
+            return true;
+        return ::MoveFileExW(temp.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        if (::rename(temp.c_str(), target.c_str()) != 0)
+            return false;
+
+        int directory = ::open(target.parent_path().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directory >= 0)
+        {
+            ::fsync(directory);
+            ::close(directory);
+        }
+        return true;
+#endif
+    }
+}
+
 namespace FileOperations
 {
     bool CreateFileK(const wxString &path)
@@ -259,4 +364,52 @@ namespace FileOperations
 
         return imageExts.contains(ext);
     }
+
+    bool IsTemporaryWriteFile(const wxString &path)
+    {
+        return wxFileNameFromPath(path).Contains(TEMPORARY_WRITE_MARKER);
+    }
+
+    uint64_t ContentHash(const char *data, size_t size, uint64_t hash)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool WriteFileAtomically(const wxString &path, const char *data, size_t size, size_t *bytesWritten)
+    {
+        if (bytesWritten)
+            *bytesWritten = 0;
+
+        if (path.empty())
+            return false;
+
+        std::error_code error;
+        fs::path target(path.ToStdWstring());
+        if (fs::is_symlink(target, error))
+        {
+            fs::path resolved = fs::canonical(target, error);
+            if (!error)
+                target = resolved;
+        }
+
+        static std::atomic<unsigned> counter{0};
+        fs::path temp = target.parent_path() / L".";
+        temp += target.filename();
+        temp += TEMPORARY_WRITE_MARKER + std::to_string(wxGetProcessId()) + "-" + std::to_string(counter++);
+
+        if (!WriteSyncedFile(temp, target, data, size) || !MoveOverFile(temp, target))
+        {
+            fs::remove(temp, error);
+            return false;
+        }
+
+        if (bytesWritten)
+            *bytesWritten = size;
+        return true;
+    }
 }
\ No newline at end of file
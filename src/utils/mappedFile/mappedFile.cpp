@@ -0,0 +1,119 @@
+#include "mappedFile/mappedFile.hpp"
+
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef __WXMSW__
+
+bool MappedFile::Open(const wxString &path)
+{
+    Close();
+
+    HANDLE file = ::CreateFileW(path.wc_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+    {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    if (size.QuadPart == 0)
+        return true;
+
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        Close();
+        return false;
+    }
+    m_mapping = mapping;
+
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const char *>(data);
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        ::UnmapViewOfFile(m_data);
+    if (m_mapping)
+        ::CloseHandle((HANDLE)m_mapping);
+    if (m_file)
+        ::CloseHandle((HANDLE)m_file);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const wxString &path)
+{
+    Close();
+
+    int fd = ::open(path.fn_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    if (status.st_size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    // The mapping keeps its own reference to the file, the descriptor is not needed anymore
+    void *data = ::mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    ::madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char *>(data);
+    m_size = (size_t)status.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        ::munmap(const_cast<char *>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif